@@ -38,11 +38,13 @@
 #include "src/tectonicPhenomenon.h"
 #include "src/movement.h"
 #include "src/erosion.h"
+#include "src/simulation.h"
 #include "src/rifting.h"
 #include "src/amplification.h"
 #include "src/ShaderProgram.h"
 #include "src/Skybox.h"
 #include "src/palette.h"
+#include "src/MeshView.h"
 
 
 
@@ -54,20 +56,24 @@ enum DisplayMode{ WIRE=0, SOLID=1, LIGHTED_WIRE=2, LIGHTED=3 };
 // ------------------------------------
 
 int nbPlates = 10;
-int nbiter_resample = 15;
+int nbiter_resample = 60; // borne haute : le rééchantillonnage est déclenché par la distorsion (cf. DistortionMonitor)
 int spherepoints = 2048 * 24;
+bool resampleScatter = true; // rééchantillonnage par dispersion sur le treillis cible (sans KD-tree)
 
 bool amplified = false;
 
 
-//Input mesh loaded at the launch of the application
-Mesh mesh;
+//Vue sur les buffers de la planete (pas de copie), avec suivi des tableaux modifies
+MeshView meshView;
+static GLuint meshDisplayList = 0;
+static bool meshDisplayListSmooth = true;
 
 Planet planet(1.0f, spherepoints);
 Movement movement_controller(planet);
 Amplification* amplificator = nullptr;
 int nbSteps = 0;
 Erosion erosion_controller(planet);
+Simulation simulation(movement_controller, erosion_controller);
 float timeStep = 1.0f;
 float elapsedSteps = 1.0f;
 
@@ -135,7 +141,7 @@ void updateDisplayedColors() {
         // planet.smoothColors();
         // planet.smoothColors();
     }
-    mesh.colors = planet.colors;
+    meshView.publish(MeshView::Colors);
     glutPostRedisplay();
 }
 
@@ -195,8 +201,9 @@ void init() {
     planet.palette = Palette::getNextPallete();
     planet.generatePlates(nbPlates);
     planet.assignCrustParameters();
+    simulation.onResample(planet);
 
-    mesh = planet;
+    meshView.attach(planet);
     display_plates_mode = 1;
     display_normals = false;
     display_mesh = true;
@@ -398,6 +405,25 @@ void drawMesh( Mesh const & i_mesh , bool draw_field = false ){
         drawTriangleMesh(i_mesh, draw_field) ; //Display with face normals
 }
 
+// La geometrie n'est renvoyee au GPU que lorsque la simulation a publie un changement
+void drawPlanetMesh( MeshView & view ){
+    unsigned int changed = view.consume();
+    if (meshDisplayList == 0) {
+        meshDisplayList = glGenLists(1);
+        changed = MeshView::All;
+    }
+    if (display_smooth_normals != meshDisplayListSmooth) {
+        meshDisplayListSmooth = display_smooth_normals;
+        changed = MeshView::All;
+    }
+    if (changed != 0) {
+        glNewList(meshDisplayList, GL_COMPILE);
+        drawMesh(view.mesh(), true);
+        glEndList();
+    }
+    glCallList(meshDisplayList);
+}
+
 
 
 
@@ -465,7 +491,9 @@ void draw() {
     }
 
     glColor3f(0.8,1,0.8);
-    drawMesh(mesh, true);
+    // Les plaques ne sont tournées qu'au moment d'afficher (repères paresseux)
+    if (meshView.isDirty(MeshView::Positions | MeshView::Normals)) planet.materializePositions();
+    drawPlanetMesh(meshView);
 
     if(displayMode == SOLID || displayMode == LIGHTED_WIRE){
         glEnable (GL_POLYGON_OFFSET_LINE);
@@ -474,7 +502,7 @@ void draw() {
         glPolygonOffset (-2.0, 1.0);
 
         glColor3f(0.,0.,0.);
-        drawMesh(mesh, false);
+        glCallList(meshDisplayList);
 
         glDisable (GL_POLYGON_OFFSET_LINE);
         glEnable (GL_LIGHTING);
@@ -485,7 +513,7 @@ void draw() {
     glDisable(GL_LIGHTING);
     if(display_normals){
         glColor3f(1.,0.,0.);
-        drawNormals(mesh);
+        drawNormals(meshView.mesh());
     }
 
     if(display_directions){
@@ -575,26 +603,31 @@ void key (unsigned char keyPressed, int x, int y) {
             break;
         }
 
-        if (nbSteps < nbiter_resample) {
-            movement_controller.movePlates(timeStep);
-            erosion_controller.erosion();
-            mesh = planet;
+        if (!simulation.needsResample()) {
+            simulation.timeStep = timeStep;
+            simulation.distortion.maxSteps = nbiter_resample;
+            simulation.advance(1);
+            meshView.publish(MeshView::Positions | MeshView::Normals);
             updateDisplayedColors();
             elapsedSteps++;
             nbSteps++;
-            printf("Moved plates: step %d\n", nbSteps);
+            const DistortionSample& distortion = simulation.distortion.last();
+            printf("Moved plates: step %d (gap %.2f, overlap %.2f, stretch %.2f)\n",
+                   nbSteps, distortion.gap, distortion.overlap, distortion.stretch);
         }else {
+            simulation.distortion.printHistory();
             movement_controller.triggerTerranesMigration();
             nbSteps = 0;
             Planet newPlanet(1.0f,spherepoints);
-            newPlanet.resample(planet);
+            newPlanet.resample(planet, simulation.distortion.resampleBand(), resampleScatter);
             
             planet = std::move(newPlanet);
             
             
             movement_controller = Movement(planet);
+            simulation.onResample(planet);
 
-            mesh = planet;
+            meshView.publish(MeshView::All);
             updateDisplayedColors();
 
             printf("Resampled planet.\n");
@@ -616,10 +649,7 @@ void key (unsigned char keyPressed, int x, int y) {
             }
             bool riftingOccurred = PlateRifting::triggerRifting(planet);
             if (riftingOccurred) {
-                std::cout << "Rifting successful! Updating structures..." << std::endl;
-                planet.findFrontierVertices();
-                planet.fillClosestFrontierVertices();
-                mesh = planet;
+                std::cout << "Rifting successful!" << std::endl;
                 updateDisplayedColors();
             } else {
                 std::cout << "No rifting occurred." << std::endl;
@@ -697,18 +727,16 @@ void key (unsigned char keyPressed, int x, int y) {
 
     case 's': //Press s key to smooth
         planet.smoothColors();
-        mesh = planet;
+        meshView.publish(MeshView::Colors);
         break;
 
     case 'e': // Press e key to increase ocean level (after amplification)
         planet.increaseWaterLevel();
-        mesh = planet;
         updateDisplayedColors();
         break;
 
     case 't': // Press d key to decrease ocean level (after amplification)
         planet.decreaseWaterLevel();
-        mesh = planet;
         updateDisplayedColors();
         break;
 
@@ -720,14 +748,15 @@ void key (unsigned char keyPressed, int x, int y) {
             }
             movement_controller.triggerTerranesMigration();
             Planet newPlanet(1.0f,spherepoints);
-            newPlanet.resample(planet);
+            newPlanet.resample(planet, simulation.distortion.resampleBand(), resampleScatter);
 
             planet = std::move(newPlanet);
 
             movement_controller.planet = &planet;
             planet.detectVerticesNeighbors();
+            simulation.onResample(planet);
             
-            mesh = planet;
+            meshView.publish(MeshView::All);
             updateDisplayedColors();
             nbSteps = 0;
             printf("Resampled planet.\n");
@@ -761,7 +790,7 @@ void key (unsigned char keyPressed, int x, int y) {
 
         planet.ocean_level = 0.5f;
         
-        mesh = planet;
+        meshView.publish(MeshView::All);
         displayMode = LIGHTED;
         display_atmosphere = true;
         
@@ -790,6 +819,7 @@ void key (unsigned char keyPressed, int x, int y) {
         amplificator = new Amplification(planet);  
 
         movement_controller = Movement(planet); 
+        simulation.onResample(planet);
 
         display_plates_mode = 1;
         displayMode = LIGHTED;
@@ -806,7 +836,7 @@ void key (unsigned char keyPressed, int x, int y) {
         }
         createAtmosphereSphere(1.1f, 64, atmosphereVAO, atmosphereVBO, atmosphereEBO, atmosphereIndexCount);
 
-        mesh = planet;
+        meshView.publish(MeshView::All);
         updateDisplayedColors();
         
         nbSteps = 0;
@@ -864,7 +894,7 @@ void key (unsigned char keyPressed, int x, int y) {
         std::cout << "Current settings:" << std::endl;
         std::cout << "  Number of plates: " << nbPlates << std::endl;
         std::cout << "  Sphere points: " << spherepoints << std::endl;
-        std::cout << "  Steps before resample: " << nbiter_resample << std::endl;
+        std::cout << "  Max steps before resample: " << nbiter_resample << std::endl;
         std::cout << "  Current step: " << nbSteps << "/" << nbiter_resample << std::endl;
         std::cout << "========================================\n" << std::endl;
     break;
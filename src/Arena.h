@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <map>
+#include <unordered_set>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+
+// Arène monotone pour les données transitoires d'un pas de simulation.
+// Les allocations avancent un pointeur dans des blocs réutilisés ; rien n'est
+// libéré avant reset(). Après le premier pas, la boucle de simulation ne fait
+// (presque) plus de malloc/free.
+class StepArena {
+public:
+    // Marqueur pour revenir en arrière (allocations temporaires d'une requête)
+    struct Marker {
+        size_t block;
+        size_t offset;
+    };
+
+    // RAII : rembobine l'arène à la sortie du scope
+    class Scope {
+    public:
+        explicit Scope(StepArena& a) : arena(a), marker(a.mark()) {}
+        ~Scope() { arena.rewind(marker); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        StepArena& arena;
+        Marker marker;
+    };
+
+    explicit StepArena(size_t blockSize = 1u << 20) : defaultBlockSize(blockSize) {}
+
+    ~StepArena() {
+        for (Block& b : blocks) std::free(b.data);
+    }
+
+    StepArena(const StepArena&) = delete;
+    StepArena& operator=(const StepArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (bytes == 0) bytes = 1;
+        while (current < blocks.size()) {
+            Block& b = blocks[current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+            uintptr_t aligned = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            size_t newOffset = (aligned - base) + bytes;
+            if (newOffset <= b.size) {
+                offset = newOffset;
+                if (offset > highWater[current]) highWater[current] = offset;
+                return reinterpret_cast<void*>(aligned);
+            }
+            // bloc plein : passer au suivant (déjà alloué lors d'un pas précédent)
+            ++current;
+            offset = 0;
+        }
+        size_t size = std::max(defaultBlockSize, bytes + alignment);
+        void* data = std::malloc(size);
+        if (!data) throw std::bad_alloc();
+        blocks.push_back(Block{static_cast<char*>(data), size});
+        highWater.push_back(0);
+        current = blocks.size() - 1;
+        offset = 0;
+        return allocate(bytes, alignment);
+    }
+
+    Marker mark() const { return Marker{current, offset}; }
+
+    void rewind(const Marker& m) {
+        current = m.block;
+        offset = m.offset;
+    }
+
+    // Début d'un nouveau pas. Si le pas précédent a débordé sur plusieurs
+    // blocs, on les fusionne en un seul bloc assez grand pour le suivant.
+    void reset() {
+        if (blocks.size() > 1) {
+            size_t total = 0;
+            for (size_t i = 0; i < blocks.size(); ++i) total += highWater[i];
+            for (Block& b : blocks) std::free(b.data);
+            blocks.clear();
+            highWater.clear();
+            size_t size = std::max(defaultBlockSize, total + total / 4);
+            void* data = std::malloc(size);
+            if (!data) throw std::bad_alloc();
+            blocks.push_back(Block{static_cast<char*>(data), size});
+            highWater.push_back(0);
+        } else if (!highWater.empty()) {
+            highWater[0] = 0;
+        }
+        current = 0;
+        offset = 0;
+    }
+
+    size_t bytesReserved() const {
+        size_t total = 0;
+        for (const Block& b : blocks) total += b.size;
+        return total;
+    }
+
+    // Arène du pas courant (thread principal). Jamais détruite : des objets
+    // globaux (Movement) peuvent encore y pointer à la fin du programme.
+    static StepArena& stepArena() {
+        static StepArena* arena = new StepArena();
+        return *arena;
+    }
+
+    // Arène propre à chaque thread pour les sections parallèles
+    static StepArena& threadArena();
+
+    // Appelée une fois par pas, hors section parallèle : remet à zéro l'arène
+    // du pas et celles de tous les threads de travail.
+    static void resetStep() {
+        stepArena().reset();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (StepArena* a : registry()) a->reset();
+    }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    struct ThreadLocalArena;
+
+    static std::vector<StepArena*>& registry() {
+        static std::vector<StepArena*> r;
+        return r;
+    }
+
+    static std::mutex& registryMutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    std::vector<Block> blocks;
+    std::vector<size_t> highWater;
+    size_t current = 0;
+    size_t offset = 0;
+    size_t defaultBlockSize;
+};
+
+struct StepArena::ThreadLocalArena {
+    StepArena arena;
+    ThreadLocalArena() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().push_back(&arena);
+    }
+    ~ThreadLocalArena() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        std::vector<StepArena*>& r = registry();
+        r.erase(std::remove(r.begin(), r.end(), &arena), r.end());
+    }
+};
+
+inline StepArena& StepArena::threadArena() {
+    thread_local ThreadLocalArena local;
+    return local.arena;
+}
+
+// Allocateur STL adossé à une StepArena (équivalent d'un std::pmr::polymorphic_allocator
+// sur un monotonic_buffer_resource, en C++14). deallocate() ne fait rien.
+template <class T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator() noexcept : arena(&StepArena::stepArena()) {}
+    explicit ArenaAllocator(StepArena& a) noexcept : arena(&a) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+
+    StepArena* arena;
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <class K, class V, class Compare = std::less<K>>
+using ArenaMap = std::map<K, V, Compare, ArenaAllocator<std::pair<const K, V>>>;
+
+template <class K, class Hash = std::hash<K>, class Equal = std::equal_to<K>>
+using ArenaUnorderedSet = std::unordered_set<K, Hash, Equal, ArenaAllocator<K>>;
+
+// Deleter pour les objets construits dans l'arène : appelle seulement le destructeur,
+// la mémoire est rendue au prochain reset().
+struct ArenaDelete {
+    template <class T>
+    void operator()(T* p) const {
+        if (p) p->~T();
+    }
+};
+
+template <class T>
+using ArenaPtr = std::unique_ptr<T, ArenaDelete>;
+
+template <class T, class... Args>
+ArenaPtr<T> makeArenaPtr(StepArena& arena, Args&&... args) {
+    void* mem = arena.allocate(sizeof(T), alignof(T));
+    return ArenaPtr<T>(new (mem) T(std::forward<Args>(args)...));
+}
@@ -0,0 +1,116 @@
+#include "BoundaryDistanceField.h"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "planet.h"
+#include "Parallel.h"
+
+// Valeur en x propagée depuis le segment [xa, xb] (valeurs ta, tb) : front plan dans le
+// triangle, minimum de λ ta + (1 - λ) tb + |x - (λ xa + (1 - λ) xb)| pour λ dans ]0, 1[.
+// Renvoie l'infini si le minimum est sur une extrémité (couvert par la mise à jour par arête)
+// ou si la causalité n'est pas respectée (triangle obtus).
+static float eikonalUpdate(const Vec3& x, const Vec3& xa, float ta, const Vec3& xb, float tb, float& lambda) {
+    const float none = std::numeric_limits<float>::max();
+    Vec3 w = xa - xb;
+    float L = w.length();
+    float delta = ta - tb;
+    if (L <= 0.0f || std::abs(delta) >= L) return none;
+
+    Vec3 u = x - xb;
+    float a = Vec3::dot(u, w) / L;
+    float h2 = u.squareLength() - a * a;
+    float h = h2 > 0.0f ? std::sqrt(h2) : 0.0f;
+
+    float s = delta * h / std::sqrt(L * L - delta * delta);
+    lambda = (a - s) / L;
+    if (!(lambda > 0.0f && lambda < 1.0f)) return none;
+
+    float t = tb + lambda * delta + std::sqrt(s * s + h * h);
+    if (t < std::max(ta, tb)) return none;
+    return t;
+}
+
+void BoundaryDistanceField::rebuild(const Planet& planet) {
+    const float far = std::numeric_limits<float>::max();
+    const unsigned int noVertex = std::numeric_limits<unsigned int>::max();
+    size_t N = planet.vertices.size();
+    distances.assign(N, far);
+    nearest.assign(N, noVertex);
+    valid = true;
+
+    if (planet.verticesToPlates.size() != N || planet.neighbors.size() != N) return;
+    const PlateBoundaryIndex& boundary = planet.boundary();
+
+    triangleOffsets.assign(N + 1, 0);
+    for (const Triangle& t : planet.triangles) {
+        for (int k = 0; k < 3; ++k) triangleOffsets[t[k] + 1]++;
+    }
+    for (size_t v = 0; v < N; ++v) triangleOffsets[v + 1] += triangleOffsets[v];
+    vertexTriangles.resize(triangleOffsets[N]);
+    {
+        std::vector<unsigned int> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (unsigned int t = 0; t < planet.triangles.size(); ++t) {
+            for (int k = 0; k < 3; ++k) vertexTriangles[fill[planet.triangles[t][k]]++] = t;
+        }
+    }
+
+    std::vector<uint8_t> accepted(N, 0);
+
+    // Les positions stockées suffisent : les distances internes à une plaque ne dépendent
+    // pas de son repère
+    parallelFor(0, planet.plates.size(), 1, [&](size_t begin, size_t end) {
+        typedef std::pair<float, unsigned int> Entry;
+        for (size_t p = begin; p < end; ++p) {
+            const Plate& plate = planet.plates[p];
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+            for (unsigned int v : plate.vertices_indices) {
+                if (planet.verticesToPlates[v] != p || !boundary.isBoundary(v)) continue;
+                distances[v] = 0.0f;
+                nearest[v] = v;
+                heap.push(Entry(0.0f, v));
+            }
+
+            while (!heap.empty()) {
+                Entry entry = heap.top();
+                heap.pop();
+                unsigned int v = entry.second;
+                if (accepted[v] || entry.first != distances[v]) continue;
+                accepted[v] = 1;
+                const Vec3& xv = planet.vertices[v];
+
+                for (unsigned int n : planet.neighbors[v]) {
+                    if (planet.verticesToPlates[n] != p || accepted[n]) continue;
+                    const Vec3& xn = planet.vertices[n];
+
+                    float best = distances[v] + (xn - xv).length();
+                    unsigned int bestNearest = nearest[v];
+
+                    // Triangles (n, v, w) dont le troisième sommet est déjà fixé
+                    for (unsigned int k = triangleOffsets[n]; k < triangleOffsets[n + 1]; ++k) {
+                        const Triangle& t = planet.triangles[vertexTriangles[k]];
+                        if (t[0] != v && t[1] != v && t[2] != v) continue;
+                        unsigned int w = t[0] ^ t[1] ^ t[2] ^ v ^ n;
+                        if (w >= N || planet.verticesToPlates[w] != p || !accepted[w]) continue;
+
+                        float lambda = 0.0f;
+                        float candidate = eikonalUpdate(xn, xv, distances[v], planet.vertices[w], distances[w], lambda);
+                        if (candidate < best) {
+                            best = candidate;
+                            bestNearest = lambda >= 0.5f ? nearest[v] : nearest[w];
+                        }
+                    }
+
+                    if (best < distances[n]) {
+                        distances[n] = best;
+                        nearest[n] = bestNearest;
+                        heap.push(Entry(best, n));
+                    }
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+class Planet;
+
+// Distance géodésique de chaque sommet à la frontière de plaque la plus proche, et ce
+// sommet frontière, par fast marching sur la triangulation (mise à jour eikonale par
+// triangle, arête seule en repli).
+// Tout chemin vers une autre plaque passe par un sommet frontière de sa propre plaque :
+// le front est propagé plaque par plaque, en parallèle, sans traverser les frontières.
+// Les plaques bougent rigidement, donc les distances internes ne changent pas d'un pas à
+// l'autre : le champ n'est reconstruit (O(N log N)) qu'après un changement de plaque ou
+// de maillage, via Planet::boundaryDistances().
+class BoundaryDistanceField {
+   public:
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    void rebuild(const Planet& planet);
+
+    float distance(unsigned int v) const { return distances[v]; }
+    // Sommet frontière le plus proche (le sommet lui-même s'il est sur une frontière)
+    unsigned int nearestBoundary(unsigned int v) const { return nearest[v]; }
+
+   private:
+    std::vector<float> distances;
+    std::vector<unsigned int> nearest;
+    // Triangles incidents à chaque sommet (format compressé)
+    std::vector<unsigned int> triangleOffsets;
+    std::vector<unsigned int> vertexTriangles;
+    bool valid = false;
+};
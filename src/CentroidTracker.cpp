@@ -0,0 +1,103 @@
+#include "CentroidTracker.h"
+
+#include <cmath>
+
+#include "planet.h"
+
+void CentroidTracker::rebuild(const Planet& planet) {
+    entries.assign(planet.plates.size(), Entry());
+
+    for (size_t p = 0; p < planet.plates.size(); ++p) {
+        const Plate& plate = planet.plates[p];
+        Entry& e = entries[p];
+
+        for (unsigned int vidx : plate.vertices_indices) {
+            if (vidx < planet.vertices.size()) {
+                e.sum += planet.vertices[vidx];
+                e.count++;
+            }
+        }
+
+        e.terraneSums.assign(plate.terranes.size(), Vec3(0.0f, 0.0f, 0.0f));
+        e.terraneCounts.assign(plate.terranes.size(), 0);
+        for (size_t t = 0; t < plate.terranes.size(); ++t) {
+            for (unsigned int vidx : plate.terranes[t]) {
+                if (vidx < planet.vertices.size()) {
+                    e.terraneSums[t] += planet.vertices[vidx];
+                    e.terraneCounts[t]++;
+                }
+            }
+        }
+    }
+    valid = true;
+}
+
+Vec3 CentroidTracker::toCentroid(const Planet& planet, unsigned int plateIdx, const Vec3& sum, unsigned int count) const {
+    if (count == 0) return Vec3(0.0f, 0.0f, 0.0f);
+    Vec3 mean = sum / static_cast<float>(count);
+    // la moyenne commute avec la rotation : un seul produit par plaque
+    Mat3 R = planet.plates[plateIdx].frameMatrix;
+    Vec3 c = R * mean;
+    c.normalize();
+    c *= planet.radius;
+    return c;
+}
+
+Vec3 CentroidTracker::plateCentroid(const Planet& planet, unsigned int plateIdx) const {
+    const Entry& e = entries[plateIdx];
+    return toCentroid(planet, plateIdx, e.sum, e.count);
+}
+
+Vec3 CentroidTracker::terraneCentroid(const Planet& planet, unsigned int plateIdx, size_t terraneIdx) const {
+    const Entry& e = entries[plateIdx];
+    return toCentroid(planet, plateIdx, e.terraneSums[terraneIdx], e.terraneCounts[terraneIdx]);
+}
+
+float CentroidTracker::plateArea(const Planet& planet, unsigned int plateIdx) const {
+    if (planet.vertices.empty()) return 0.0f;
+    float cellArea = 4.0f * (float)M_PI * planet.radius * planet.radius / (float)planet.vertices.size();
+    return cellArea * (float)entries[plateIdx].count;
+}
+
+float CentroidTracker::terraneArea(const Planet& planet, unsigned int plateIdx, size_t terraneIdx) const {
+    if (planet.vertices.empty()) return 0.0f;
+    float cellArea = 4.0f * (float)M_PI * planet.radius * planet.radius / (float)planet.vertices.size();
+    return cellArea * (float)entries[plateIdx].terraneCounts[terraneIdx];
+}
+
+void CentroidTracker::transferVertices(const Planet& planet, const std::vector<unsigned int>& vertices,
+                                       unsigned int fromPlate, size_t fromTerrane,
+                                       unsigned int toPlate, size_t toTerrane) {
+    Entry& from = entries[fromPlate];
+    Entry& to = entries[toPlate];
+
+    Vec3 moved(0.0f, 0.0f, 0.0f);
+    for (unsigned int vidx : vertices) moved += planet.vertices[vidx];
+    unsigned int n = (unsigned int)vertices.size();
+
+    from.sum -= moved;
+    from.count -= n;
+    from.terraneSums[fromTerrane] -= moved;
+    from.terraneCounts[fromTerrane] -= n;
+
+    to.sum += moved;
+    to.count += n;
+    to.terraneSums[toTerrane] += moved;
+    to.terraneCounts[toTerrane] += n;
+}
+
+void CentroidTracker::eraseTerrane(unsigned int plateIdx, size_t terraneIdx) {
+    Entry& e = entries[plateIdx];
+    e.terraneSums.erase(e.terraneSums.begin() + terraneIdx);
+    e.terraneCounts.erase(e.terraneCounts.begin() + terraneIdx);
+}
+
+void CentroidTracker::applyFrames(const Planet& planet) {
+    if (!valid) return;
+    for (size_t p = 0; p < entries.size(); ++p) {
+        Mat3 R = planet.plates[p].frameMatrix;
+        Entry& e = entries[p];
+        e.sum = R * e.sum;
+        for (Vec3& s : e.terraneSums) s = R * s;
+    }
+}
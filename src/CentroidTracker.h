@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Vec3.h"
+
+class Planet;
+
+// Centroïdes et aires des plaques et des terranes, partagés par la détection des
+// phénomènes, l'affichage des flèches et la migration des terranes.
+// On garde la somme des positions stockées (repère de la plaque) : comme les plaques
+// tournent rigidement, le centroïde courant est la rotation de cette moyenne.
+// Les sommes sont corrigées incrémentalement quand des sommets changent de plaque ;
+// tout autre changement de découpage invalide le tracker, reconstruit au prochain accès.
+class CentroidTracker {
+   public:
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    void rebuild(const Planet& planet);
+
+    Vec3 plateCentroid(const Planet& planet, unsigned int plateIdx) const;
+    Vec3 terraneCentroid(const Planet& planet, unsigned int plateIdx, size_t terraneIdx) const;
+
+    unsigned int plateVertexCount(unsigned int plateIdx) const { return entries[plateIdx].count; }
+    // Aire approchée : les sommets de la sphère échantillonnent des cellules d'aire égale
+    float plateArea(const Planet& planet, unsigned int plateIdx) const;
+    float terraneArea(const Planet& planet, unsigned int plateIdx, size_t terraneIdx) const;
+
+    // Transfert de sommets entre deux terranes (positions matérialisées)
+    void transferVertices(const Planet& planet, const std::vector<unsigned int>& vertices,
+                          unsigned int fromPlate, size_t fromTerrane,
+                          unsigned int toPlate, size_t toTerrane);
+    void eraseTerrane(unsigned int plateIdx, size_t terraneIdx);
+
+    // Appelée par Planet::materializePositions avant de remettre les repères à l'identité
+    void applyFrames(const Planet& planet);
+
+   private:
+    struct Entry {
+        Vec3 sum = Vec3(0.0f, 0.0f, 0.0f);
+        unsigned int count = 0;
+        std::vector<Vec3> terraneSums;
+        std::vector<unsigned int> terraneCounts;
+    };
+
+    Vec3 toCentroid(const Planet& planet, unsigned int plateIdx, const Vec3& sum, unsigned int count) const;
+
+    std::vector<Entry> entries;
+    bool valid = false;
+};
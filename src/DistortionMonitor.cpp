@@ -0,0 +1,82 @@
+#include "DistortionMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "planet.h"
+
+void DistortionMonitor::reset(const Planet& planet) {
+    size_t N = planet.vertices.size();
+    reference.resize(N);
+    for (unsigned int v = 0; v < N; ++v) reference[v] = planet.positionOf(v);
+
+    double sum = 0.0;
+    size_t count = 0;
+    if (planet.neighbors.size() == N) {
+        for (unsigned int v = 0; v < N; ++v) {
+            for (unsigned int n : planet.neighbors[v]) {
+                if (n <= v) continue;
+                sum += (reference[v] - reference[n]).length();
+                count++;
+            }
+        }
+    }
+    edgeLength = count > 0 ? (float)(sum / count) : 0.0f;
+    samples.clear();
+}
+
+const DistortionSample& DistortionMonitor::observe(const Planet& planet) {
+    if (reference.size() != planet.vertices.size()) reset(planet);
+
+    DistortionSample sample;
+    sample.step = (unsigned int)samples.size() + 1;
+
+    if (edgeLength > 0.0f && planet.verticesToPlates.size() == reference.size()) {
+        float invEdge = 1.0f / edgeLength;
+        for (unsigned int v : planet.boundary().vertices()) {
+            unsigned int plate = planet.verticesToPlates[v];
+            Vec3 p = planet.positionOf(v);
+            for (unsigned int n : planet.neighbors[v]) {
+                if (planet.verticesToPlates[n] == plate) continue;
+
+                Vec3 edge = p - planet.positionOf(n);
+                Vec3 restEdge = reference[v] - reference[n];
+                float restLengthSq = restEdge.squareLength();
+                if (restLengthSq <= 0.0f) continue;
+
+                float displacement = (edge - restEdge).length() * invEdge;
+                // projection sur l'arête de référence : > 1 allongée, < 1 raccourcie ou croisée
+                if (Vec3::dot(edge, restEdge) >= restLengthSq) sample.gap = std::max(sample.gap, displacement);
+                else sample.overlap = std::max(sample.overlap, displacement);
+
+                sample.stretch = std::max(sample.stretch, std::sqrt(edge.squareLength() / restLengthSq));
+            }
+        }
+    }
+
+    samples.push_back(sample);
+    return samples.back();
+}
+
+bool DistortionMonitor::needsResample() const {
+    if (samples.empty()) return false;
+    const DistortionSample& s = samples.back();
+    if (maxSteps > 0 && s.step >= maxSteps) return true;
+    return s.gap > maxGap || s.overlap > maxOverlap || s.stretch > maxStretch;
+}
+
+unsigned int DistortionMonitor::resampleBand() const {
+    if (samples.empty()) return 0;
+    // une plaque a pu avancer de max(gap, overlap) arêtes sur sa voisine, plus la marge
+    // couverte par les k plus proches voisins de la reprojection
+    const DistortionSample& s = samples.back();
+    return (unsigned int)std::ceil(std::max(s.gap, s.overlap)) + 4;
+}
+
+void DistortionMonitor::printHistory() const {
+    printf("Distortion since last resample (gap/overlap in edge lengths):\n");
+    for (const DistortionSample& s : samples) {
+        printf("  step %3u  gap %6.2f  overlap %6.2f  stretch %6.2f\n", s.step, s.gap, s.overlap, s.stretch);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "Vec3.h"
+
+class Planet;
+
+// Mesure de la distorsion du maillage depuis le dernier rééchantillonnage.
+// Les intérieurs des plaques bougent rigidement : seules les arêtes entre deux plaques
+// se déforment. À chaque pas on compare ces arêtes à leur état de référence :
+//  - gap : déplacement relatif (en longueurs d'arête) des arêtes qui s'allongent (divergence),
+//  - overlap : idem pour les arêtes qui raccourcissent ou se croisent (convergence),
+//  - stretch : rapport longueur / longueur de référence le plus grand (triangles étirés).
+// Coût O(sommets frontière) par pas.
+struct DistortionSample {
+    unsigned int step = 0;
+    float gap = 0.0f;
+    float overlap = 0.0f;
+    float stretch = 1.0f;
+};
+
+class DistortionMonitor {
+   public:
+    // Seuils de déclenchement (configurables). Les valeurs par défaut correspondent à
+    // environ 15 pas pour les plaques les plus rapides, l'ancien intervalle fixe.
+    float maxGap = 5.0f;        // en longueurs d'arête
+    float maxOverlap = 5.5f;    // en longueurs d'arête
+    float maxStretch = 6.5f;
+    unsigned int maxSteps = 60; // borne haute, 0 = aucune
+
+    // Nouvelle référence (juste après un rééchantillonnage)
+    void reset(const Planet& planet);
+    bool isReset() const { return !reference.empty(); }
+
+    // Mesure l'état courant et l'ajoute à l'historique
+    const DistortionSample& observe(const Planet& planet);
+
+    // Un seuil est dépassé par la dernière mesure
+    bool needsResample() const;
+
+    // Largeur (en anneaux d'arêtes) de la bande à reprojeter autour des frontières pour un
+    // rééchantillonnage partiel ; 0 si aucune mesure (rééchantillonnage complet)
+    unsigned int resampleBand() const;
+
+    const std::vector<DistortionSample>& history() const { return samples; }
+    const DistortionSample& last() const { return samples.empty() ? initial : samples.back(); }
+    void printHistory() const;
+
+   private:
+    std::vector<Vec3> reference;   // positions au dernier rééchantillonnage
+    float edgeLength = 0.0f;       // longueur moyenne d'une arête de référence
+    std::vector<DistortionSample> samples;
+    DistortionSample initial;
+};
@@ -0,0 +1,169 @@
+#include "FibonacciScatter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "planet.h"
+#include "Parallel.h"
+
+namespace {
+
+// Même normalisation que SphericalKDTree, pour des distances identiques au bit près
+Vec3 normalized(const Vec3& p) {
+    float len = p.length();
+    return (len > 1e-12f) ? (p / len) : p;
+}
+
+float distance2(const Vec3& a, const Vec3& q) {
+    float dx = a[0] - q[0], dy = a[1] - q[1], dz = a[2] - q[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+typedef FlatKDTree::Neighbor Candidate;
+
+const float unbounded = std::numeric_limits<float>::max();
+
+// Plus proche source annotée, et plus proche source sur une autre plaque que celle-ci
+struct TwoPlatesCollector {
+    const Planet& planet;
+    Candidate first{unbounded, FibonacciScatter::noIndex};
+    Candidate second{unbounded, FibonacciScatter::noIndex};
+    explicit TwoPlatesCollector(const Planet& p) : planet(p) {}
+
+    float bound() const { return second.dist2; }
+    void offer(float dist2, uint32_t id) {
+        unsigned int plate = planet.verticesToPlates[id];
+        if (plate >= planet.plates.size()) return;
+        Candidate c{dist2, id};
+        bool hasFirst = first.id != FibonacciScatter::noIndex;
+        unsigned int firstPlate = hasFirst ? planet.verticesToPlates[first.id] : plate;
+        if (!hasFirst || c < first) {
+            // l'ancien premier est le meilleur des plaques autres que celle de c
+            if (hasFirst && plate != firstPlate) second = first;
+            first = c;
+        } else if (plate != firstPlate && c < second) {
+            second = c;
+        }
+    }
+};
+
+}  // namespace
+
+bool FibonacciScatter::applicable(const Planet& target) {
+    return target.isSphere && target.vertices.size() >= 4 && target.neighbors.size() == target.vertices.size();
+}
+
+FibonacciScatter::FibonacciScatter(const Planet& target, const Planet& source) : target(target), source(source) {
+    size_t T = target.vertices.size();
+    size_t S = source.vertices.size();
+    targetPoints.resize(T);
+    sourcePoints.resize(S);
+    parallelFor(0, T, 4096, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) targetPoints[t] = normalized(target.vertices[t]);
+    });
+
+    // Dispersion : cellule de chaque source, descente depuis l'inverse analytique
+    std::vector<uint32_t> cellOf(S);
+    parallelFor(0, S, 4096, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            Vec3 p = normalized(source.vertices[s]);
+            sourcePoints[s] = p;
+            unsigned int c = fibonacciSphereIndex(p, (unsigned int)T);
+            float d2 = distance2(targetPoints[c], p);
+            for (bool improved = true; improved;) {
+                improved = false;
+                for (unsigned int n : target.neighbors[c]) {
+                    float nd2 = distance2(targetPoints[n], p);
+                    if (nd2 < d2) {
+                        d2 = nd2;
+                        c = n;
+                        improved = true;
+                    }
+                }
+            }
+            cellOf[s] = c;
+        }
+    });
+
+    cellOffsets.assign(T + 1, 0);
+    for (uint32_t c : cellOf) cellOffsets[c + 1]++;
+    for (size_t t = 0; t < T; ++t) cellOffsets[t + 1] += cellOffsets[t];
+    cellSources.resize(S);
+    std::vector<uint32_t> fill(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (uint32_t s = 0; s < S; ++s) cellSources[fill[cellOf[s]]++] = s;
+}
+
+// Parcours en largeur des cellules autour de t ; une cellule n'est développée que si elle
+// est à moins de 2R de t, R étant la borne courante du collecteur. Cela suffit : dans une
+// triangulation de Delaunay, toute cellule a un voisin plus proche de t (routage glouton),
+// les cellules du disque de rayon 2R sont donc reliées à t à l'intérieur du disque.
+template <class Collector>
+void FibonacciScatter::explore(unsigned int t, VisitMarks& marks, Collector& collector) const {
+    const Vec3& q = targetPoints[t];
+    marks.begin(targetPoints.size());
+    marks.visit(t);
+
+    for (size_t head = 0; head < marks.queue.size(); ++head) {
+        unsigned int c = marks.queue[head];
+        for (uint32_t k = cellOffsets[c]; k < cellOffsets[c + 1]; ++k) {
+            uint32_t s = cellSources[k];
+            collector.offer(distance2(sourcePoints[s], q), s);
+        }
+
+        // (2R)^2, avec une petite marge pour les arrondis
+        float bound = collector.bound();
+        if (bound != unbounded && distance2(targetPoints[c], q) > 4.0001f * bound + 1e-12f) continue;
+        for (unsigned int n : target.neighbors[c]) marks.visit(n);
+    }
+}
+
+void FibonacciScatter::nearest(uint32_t* out) const {
+    size_t T = targetPoints.size();
+    parallelFor(0, T, 2048, [&](size_t begin, size_t end) {
+        VisitMarks marks;
+        for (size_t t = begin; t < end; ++t) {
+            NearestCollector collector(1);
+            explore((unsigned int)t, marks, collector);
+            out[t] = collector.count > 0 ? collector.items[0].id : 0;
+        }
+    });
+}
+
+void FibonacciScatter::kNearest(const std::vector<uint32_t>& targets, unsigned int k, uint32_t* out) const {
+    parallelFor(0, targets.size(), 1024, [&](size_t begin, size_t end) {
+        VisitMarks marks;
+        for (size_t i = begin; i < end; ++i) {
+            NearestCollector collector(k);
+            explore(targets[i], marks, collector);
+            uint32_t* row = out + i * k;
+            for (unsigned int j = 0; j < k; ++j) row[j] = j < collector.count ? collector.items[j].id : noIndex;
+        }
+    });
+}
+
+void FibonacciScatter::nearestFromDifferentPlates(const std::vector<unsigned int>& targets,
+                                                  std::vector<std::pair<uint32_t, uint32_t>>& out) const {
+    out.assign(targets.size(), std::make_pair(0u, 1u));
+    if (source.verticesToPlates.size() != sourcePoints.size()) return;
+    parallelFor(0, targets.size(), 256, [&](size_t begin, size_t end) {
+        VisitMarks marks;
+        for (size_t i = begin; i < end; ++i) {
+            TwoPlatesCollector collector(source);
+            explore(targets[i], marks, collector);
+            if (collector.second.id != noIndex) out[i] = std::make_pair(collector.first.id, collector.second.id);
+        }
+    });
+}
+
+size_t FibonacciScatter::emptyCells() const {
+    size_t count = 0;
+    for (size_t t = 0; t + 1 < cellOffsets.size(); ++t) count += cellOffsets[t + 1] == cellOffsets[t];
+    return count;
+}
+
+size_t FibonacciScatter::crowdedCells() const {
+    size_t count = 0;
+    for (size_t t = 0; t + 1 < cellOffsets.size(); ++t) count += cellOffsets[t + 1] - cellOffsets[t] > 1;
+    return count;
+}
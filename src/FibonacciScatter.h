@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "NeighborCollectors.h"
+#include "Vec3.h"
+
+class Planet;
+
+// Correspondance sources déplacées → treillis de Fibonacci cible, sans index spatial.
+// Chaque sommet source est dispersé dans la cellule du point cible le plus proche
+// (inverse analytique du treillis, puis descente locale), en O(1). Les requêtes d'un
+// sommet cible parcourent ensuite les cellules voisines par anneaux : une source s à
+// distance R de la cible t est dans une cellule c avec |c - t| <= 2R (c est plus proche
+// de s que t), l'exploration s'arrête donc dès que les cellules dépassent 2R. Les
+// cellules vides (trous) et multiples (chevauchements) sont ainsi traitées comme les autres.
+// Résultats identiques à SphericalKDTree (même métrique, même départage par indice).
+class FibonacciScatter {
+   public:
+    enum : uint32_t { noIndex = 0xffffffffu };
+
+    // target : sphère de setupSphere, voisins détectés ; source : positions matérialisées
+    FibonacciScatter(const Planet& target, const Planet& source);
+    static bool applicable(const Planet& target);
+
+    // out[t] : source la plus proche de chaque sommet cible (out préalloué)
+    void nearest(uint32_t* out) const;
+    // out[i * k + j] : j-ème source la plus proche de targets[i], noIndex au-delà
+    void kNearest(const std::vector<uint32_t>& targets, unsigned int k, uint32_t* out) const;
+    // (plus proche source, plus proche source sur une autre plaque) pour chaque cible
+    void nearestFromDifferentPlates(const std::vector<unsigned int>& targets,
+                                    std::vector<std::pair<uint32_t, uint32_t>>& out) const;
+
+    size_t emptyCells() const;
+    size_t crowdedCells() const;
+
+   private:
+    template <class Collector>
+    void explore(unsigned int t, VisitMarks& marks, Collector& collector) const;
+
+    const Planet& target;
+    const Planet& source;
+    std::vector<Vec3> targetPoints;  // normalisés
+    std::vector<Vec3> sourcePoints;
+    // Sources de chaque cellule (format compressé, ordre des indices source)
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellSources;
+};
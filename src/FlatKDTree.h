@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Vec3.h"
+
+// KD-tree 3D à plat : les points sont réordonnés dans un seul tableau, le nœud d'un
+// intervalle [begin, end) est son milieu (médiane sur l'axe de plus grande étendue),
+// les intervalles d'au plus leafSize points sont des feuilles parcourues linéairement.
+// Coordonnées float en SoA, distance euclidienne au carré, aucune allocation pendant
+// les requêtes (pile et tas des k plus proches de taille fixe) : les requêtes const
+// peuvent être lancées depuis plusieurs threads.
+// À distance égale le plus petit identifiant gagne, quel que soit l'ordre de parcours.
+class FlatKDTree {
+   public:
+    static const unsigned int maxK = 64;      // k maximal des requêtes kNearest
+    static const unsigned int leafSize = 8;
+
+    struct Neighbor {
+        float dist2;
+        uint32_t id;
+        bool operator<(const Neighbor& o) const { return dist2 < o.dist2 || (dist2 == o.dist2 && id < o.id); }
+    };
+
+    // Départ à chaud pour une suite de requêtes voisines : la feuille du meilleur résultat
+    // précédent est parcourue en premier, ce qui resserre la borne avant la descente.
+    // Le résultat est le même qu'une requête à froid.
+    struct WarmStart {
+        uint32_t begin = 0, end = 0;
+    };
+
+    FlatKDTree() {}
+
+    // ids[i] : identifiant renvoyé pour points[i] (indice dans le tableau si ids est vide)
+    void build(const std::vector<Vec3>& points, const std::vector<uint32_t>& ids = std::vector<uint32_t>()) {
+        size_t n = points.size();
+        std::vector<uint32_t> order(n);
+        for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+
+        splitDim.assign(n, 0);
+        buildRange(points, order, 0, n);
+
+        for (int d = 0; d < 3; ++d) coords[d].resize(n);
+        pointIds.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const Vec3& p = points[order[i]];
+            coords[0][i] = p[0];
+            coords[1][i] = p[1];
+            coords[2][i] = p[2];
+            pointIds[i] = ids.empty() ? order[i] : ids[order[i]];
+        }
+    }
+
+    size_t size() const { return pointIds.size(); }
+    bool empty() const { return pointIds.empty(); }
+
+    // Plus proche point accepté par accept(id) ; faux si aucun
+    template <class Accept>
+    bool nearestIf(const Vec3& q, Accept accept, Neighbor& result, WarmStart* warm = nullptr) const {
+        KHeap heap(1);
+        search(q, accept, heap, warm);
+        if (heap.count == 0) return false;
+        result = heap.items[0];
+        return true;
+    }
+
+    uint32_t nearest(const Vec3& q, WarmStart* warm = nullptr) const {
+        Neighbor result;
+        if (!nearestIf(q, AcceptAll(), result, warm)) return 0;
+        return result.id;
+    }
+
+    // k plus proches (k <= maxK) acceptés, triés par distance croissante ; renvoie leur nombre
+    template <class Accept>
+    unsigned int kNearestIf(const Vec3& q, unsigned int k, Accept accept, Neighbor* out,
+                            WarmStart* warm = nullptr) const {
+        KHeap heap(std::min(k, (unsigned int)maxK));
+        search(q, accept, heap, warm);
+        std::sort_heap(heap.items, heap.items + heap.count);
+        std::copy(heap.items, heap.items + heap.count, out);
+        return heap.count;
+    }
+
+    unsigned int kNearest(const Vec3& q, unsigned int k, Neighbor* out, WarmStart* warm = nullptr) const {
+        return kNearestIf(q, k, AcceptAll(), out, warm);
+    }
+
+   private:
+    struct AcceptAll {
+        bool operator()(uint32_t) const { return true; }
+    };
+
+    // Tas max des k meilleurs, sur la pile
+    struct KHeap {
+        Neighbor items[maxK];
+        unsigned int count = 0;
+        unsigned int capacity;
+        explicit KHeap(unsigned int k) : capacity(k) {}
+
+        float worst() const {
+            return count < capacity ? std::numeric_limits<float>::max() : items[0].dist2;
+        }
+        void offer(float dist2, uint32_t id) {
+            Neighbor candidate{dist2, id};
+            if (count < capacity) {
+                items[count++] = candidate;
+                std::push_heap(items, items + count);
+            } else if (candidate < items[0]) {
+                std::pop_heap(items, items + count);
+                items[count - 1] = candidate;
+                std::push_heap(items, items + count);
+            }
+        }
+    };
+
+    void buildRange(const std::vector<Vec3>& points, std::vector<uint32_t>& order, size_t begin, size_t end) {
+        if (end - begin <= leafSize) return;
+
+        float lo[3], hi[3];
+        for (int d = 0; d < 3; ++d) {
+            lo[d] = std::numeric_limits<float>::max();
+            hi[d] = -std::numeric_limits<float>::max();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const Vec3& p = points[order[i]];
+            for (int d = 0; d < 3; ++d) {
+                lo[d] = std::min(lo[d], p[d]);
+                hi[d] = std::max(hi[d], p[d]);
+            }
+        }
+        int dim = 0;
+        for (int d = 1; d < 3; ++d) {
+            if (hi[d] - lo[d] > hi[dim] - lo[dim]) dim = d;
+        }
+
+        size_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return points[a][dim] < points[b][dim]; });
+        splitDim[mid] = (uint8_t)dim;
+
+        buildRange(points, order, begin, mid);
+        buildRange(points, order, mid + 1, end);
+    }
+
+    template <class Accept>
+    void search(const Vec3& q, Accept& accept, KHeap& heap, WarmStart* warm) const {
+        struct Range {
+            uint32_t begin, end;
+            float minDist2;  // borne inférieure de la distance au carré à l'intervalle
+        };
+        Range stack[128];
+        unsigned int top = 0;
+        Range root{0, (uint32_t)pointIds.size(), 0.0f};
+
+        const float qx = q[0], qy = q[1], qz = q[2];
+        const float* xs = coords[0].data();
+        const float* ys = coords[1].data();
+        const float* zs = coords[2].data();
+
+        // meilleur point vu dans une feuille, pour le départ à chaud suivant
+        Neighbor best{std::numeric_limits<float>::max(), std::numeric_limits<uint32_t>::max()};
+        WarmStart bestLeaf;
+
+        auto visit = [&](uint32_t i) {
+            float dx = xs[i] - qx, dy = ys[i] - qy, dz = zs[i] - qz;
+            float d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 <= heap.worst() && accept(pointIds[i])) {
+                heap.offer(d2, pointIds[i]);
+                return Neighbor{d2, pointIds[i]};
+            }
+            return Neighbor{std::numeric_limits<float>::max(), std::numeric_limits<uint32_t>::max()};
+        };
+        auto visitLeaf = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                Neighbor n = visit(i);
+                if (n < best) {
+                    best = n;
+                    bestLeaf.begin = begin;
+                    bestLeaf.end = end;
+                }
+            }
+        };
+
+        WarmStart start;
+        if (warm && warm->end > warm->begin && warm->end <= pointIds.size()) {
+            start = *warm;
+            visitLeaf(start.begin, start.end);
+
+            // On descend vers la feuille de départ tant que la boule de rayon la borne actuelle
+            // reste du même côté des plans de coupe : l'autre côté et le point de coupe (sur le
+            // plan) ne peuvent pas entrer dans le résultat, la recherche part de ce sous-arbre
+            float bound = heap.worst();
+            while (root.end - root.begin > leafSize) {
+                uint32_t mid = root.begin + (root.end - root.begin) / 2;
+                int dim = splitDim[mid];
+                float diff = q[dim] - coords[dim][mid];
+                bool below = start.begin < mid;
+                if ((below ? diff >= 0.0f : diff < 0.0f) || diff * diff <= bound) break;
+                if (below) root.end = mid;
+                else root.begin = mid + 1;
+            }
+        }
+        if (root.end > root.begin) stack[top++] = root;
+
+        while (top > 0) {
+            Range r = stack[--top];
+            if (r.minDist2 > heap.worst()) continue;
+
+            if (r.end - r.begin <= leafSize) {
+                // les feuilles sont des intervalles disjoints : celle du départ à chaud est déjà vue
+                if (r.begin != start.begin || r.end != start.end) visitLeaf(r.begin, r.end);
+                continue;
+            }
+
+            uint32_t mid = r.begin + (r.end - r.begin) / 2;
+            visit(mid);
+
+            int dim = splitDim[mid];
+            float diff = q[dim] - coords[dim][mid];
+            Range below{r.begin, mid, r.minDist2};
+            Range above{mid + 1, r.end, r.minDist2};
+            Range& nearSide = diff < 0.0f ? below : above;
+            Range& farSide = diff < 0.0f ? above : below;
+            farSide.minDist2 = std::max(r.minDist2, diff * diff);
+
+            // le côté proche est dépilé en premier
+            if (farSide.end > farSide.begin) stack[top++] = farSide;
+            if (nearSide.end > nearSide.begin) stack[top++] = nearSide;
+        }
+
+        if (warm && bestLeaf.end > bestLeaf.begin) *warm = bestLeaf;
+    }
+
+    std::vector<float> coords[3];
+    std::vector<uint32_t> pointIds;
+    std::vector<uint8_t> splitDim;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include "Vec3.h"
+#include "mesh.h"
+
+// Vue non propriétaire sur les buffers d'un Mesh (en pratique la Planet simulée).
+// Le rendu lit directement les tableaux de la planète, sans copie ; la simulation
+// publie seulement quels tableaux ont changé depuis le dernier affichage.
+class MeshView {
+   public:
+    enum Buffer : unsigned int {
+        Positions = 1u << 0,
+        Normals   = 1u << 1,
+        Colors    = 1u << 2,
+        Topology  = 1u << 3,
+        All       = Positions | Normals | Colors | Topology
+    };
+
+    MeshView() {}
+    explicit MeshView(const Mesh& m) { attach(m); }
+
+    // (Re)brancher la vue ; tout est considéré comme modifié
+    void attach(const Mesh& m) {
+        source = &m;
+        dirty = All;
+        ++version;
+    }
+
+    // Signaler que certains tableaux de la source ont changé
+    void publish(unsigned int buffers) {
+        dirty |= buffers;
+        ++version;
+    }
+
+    // Récupérer (et remettre à zéro) les tableaux modifiés depuis le dernier appel
+    unsigned int consume() {
+        unsigned int changed = dirty;
+        dirty = 0;
+        return changed;
+    }
+
+    bool isDirty(unsigned int buffers = All) const { return (dirty & buffers) != 0; }
+    unsigned long getVersion() const { return version; }
+    bool empty() const { return source == nullptr; }
+
+    const Mesh& mesh() const { return *source; }
+    const std::vector<Vec3>& vertices() const { return source->vertices; }
+    const std::vector<Vec3>& normals() const { return source->normals; }
+    const std::vector<Vec3>& colors() const { return source->colors; }
+    const std::vector<Triangle>& triangles() const { return source->triangles; }
+
+   private:
+    const Mesh* source = nullptr;
+    unsigned int dirty = All;
+    unsigned long version = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "FlatKDTree.h"
+
+// Outils communs aux recherches par parcours de cellules (FibonacciScatter, SphericalGrid) :
+// le parcours propose des candidats (offer) et s'arrête selon la borne du collecteur (bound).
+
+// k meilleurs candidats, triés (k petit : insertion) ; même ordre que FlatKDTree
+struct NearestCollector {
+    FlatKDTree::Neighbor items[FlatKDTree::maxK];
+    unsigned int count = 0;
+    unsigned int k;
+    explicit NearestCollector(unsigned int k) : k(std::min(std::max(k, 1u), (unsigned int)FlatKDTree::maxK)) {}
+
+    float bound() const { return count < k ? std::numeric_limits<float>::max() : items[k - 1].dist2; }
+    void offer(float dist2, uint32_t id) {
+        FlatKDTree::Neighbor c{dist2, id};
+        if (count == k && !(c < items[k - 1])) return;
+        unsigned int i = count < k ? count++ : k - 1;
+        for (; i > 0 && c < items[i - 1]; --i) items[i] = items[i - 1];
+        items[i] = c;
+    }
+};
+
+// Marques de visite des cellules (numéro de parcours, remis à zéro seulement au débordement)
+struct VisitMarks {
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> queue;
+    uint32_t current = 0;
+
+    // Nouveau parcours sur `cells` cellules
+    void begin(size_t cells) {
+        if (stamp.size() < cells) stamp.resize(cells, 0);
+        if (++current == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            current = 1;
+        }
+        queue.clear();
+    }
+    // Vrai si c n'était pas encore marquée ; la marque et la met en file
+    bool visit(uint32_t c) {
+        if (stamp[c] == current) return false;
+        stamp[c] = current;
+        queue.push_back(c);
+        return true;
+    }
+};
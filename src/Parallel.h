@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Petit pool de threads persistant pour les sections parallèles de la simulation.
+// Les threads sont créés une seule fois (pas de création/destruction à chaque pas),
+// ce qui permet aussi de garder leurs arènes thread_local d'un pas à l'autre.
+class ParallelPool {
+   public:
+    static ParallelPool& instance() {
+        // Jamais détruit : les workers restent bloqués jusqu'à la fin du processus
+        static ParallelPool* pool = new ParallelPool(defaultThreadCount());
+        return *pool;
+    }
+
+    // Nombre total de threads utilisés (thread appelant compris)
+    unsigned int size() const { return (unsigned int)workers.size() + 1; }
+
+    void setThreadCount(unsigned int n) {
+        if (n == 0) n = 1;
+        stopWorkers();
+        startWorkers(n - 1);
+    }
+
+    // Exécute fn(chunk) pour chaque chunk de [0, nChunks). Le thread appelant participe.
+    // Un appel depuis un worker (section imbriquée) s'exécute en séquentiel.
+    void run(size_t nChunks, const std::function<void(size_t)>& fn) {
+        if (nChunks == 0) return;
+        if (workers.empty() || nChunks == 1 || insideWorker()) {
+            for (size_t c = 0; c < nChunks; ++c) fn(c);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job = &fn;
+        jobChunks = nChunks;
+        nextChunk.store(0);
+        finishedChunks = 0;
+        ++generation;
+        lock.unlock();
+        wakeUp.notify_all();
+
+        size_t done = work(fn, nChunks);
+
+        // Attendre aussi les workers entrés dans cette génération : aucun ne doit encore
+        // tenir fn, ni un indice de nextChunk, quand le prochain run() le remet à zéro
+        lock.lock();
+        finishedChunks += done;
+        allDone.wait(lock, [this] { return finishedChunks == jobChunks && activeWorkers == 0; });
+        job = nullptr;
+    }
+
+   private:
+    explicit ParallelPool(unsigned int n) { startWorkers(n > 0 ? n - 1 : 0); }
+
+    static unsigned int defaultThreadCount() {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+    static bool& insideWorker() {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    // fn et nChunks sont ceux de la génération lue sous le verrou
+    size_t work(const std::function<void(size_t)>& fn, size_t nChunks) {
+        size_t done = 0;
+        for (;;) {
+            size_t c = nextChunk.fetch_add(1);
+            if (c >= nChunks) break;
+            fn(c);
+            ++done;
+        }
+        return done;
+    }
+
+    void workerLoop() {
+        insideWorker() = true;
+        unsigned long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wakeUp.wait(lock, [&] { return stopping || (generation != seen && job != nullptr); });
+            if (stopping) return;
+            seen = generation;
+            const std::function<void(size_t)>* fn = job;
+            size_t nChunks = jobChunks;
+            ++activeWorkers;
+            lock.unlock();
+            size_t done = work(*fn, nChunks);
+            lock.lock();
+            finishedChunks += done;
+            --activeWorkers;
+            if (finishedChunks == jobChunks && activeWorkers == 0) allDone.notify_all();
+        }
+    }
+
+    void startWorkers(unsigned int n) {
+        stopping = false;
+        for (unsigned int i = 0; i < n; ++i) workers.emplace_back(&ParallelPool::workerLoop, this);
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& t : workers) t.join();
+        workers.clear();
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobChunks = 0;
+    size_t finishedChunks = 0;
+    unsigned int activeWorkers = 0;  // workers entrés dans la génération courante, pas encore sortis
+    std::atomic<size_t> nextChunk{0};
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+// fn(begin, end) sur des sous-intervalles de [begin, end) d'au moins `grain` éléments
+template <class F>
+inline void parallelFor(size_t begin, size_t end, size_t grain, F fn) {
+    if (end <= begin) return;
+    ParallelPool& pool = ParallelPool::instance();
+    size_t n = end - begin;
+    if (grain == 0) grain = 1;
+    if (pool.size() <= 1 || n <= grain) {
+        fn(begin, end);
+        return;
+    }
+    size_t nChunks = std::min((n + grain - 1) / grain, (size_t)pool.size() * 4);
+    size_t chunk = (n + nChunks - 1) / nChunks;
+    pool.run(nChunks, [&](size_t c) {
+        size_t b = begin + c * chunk;
+        size_t e = std::min(end, b + chunk);
+        if (b < e) fn(b, e);
+    });
+}
+
+// Découpage fixe en blocs de `chunkSize`, indépendant du nombre de threads :
+// fn(chunkIndex, begin, end). À utiliser quand le résultat doit être reproductible
+// (tampons par bloc fusionnés ensuite dans l'ordre des blocs).
+template <class F>
+inline void parallelChunks(size_t n, size_t chunkSize, F fn) {
+    if (n == 0) return;
+    if (chunkSize == 0) chunkSize = 1;
+    size_t nChunks = (n + chunkSize - 1) / chunkSize;
+    ParallelPool::instance().run(nChunks, [&](size_t c) {
+        size_t b = c * chunkSize;
+        size_t e = std::min(n, b + chunkSize);
+        fn(c, b, e);
+    });
+}
@@ -0,0 +1,71 @@
+#include "PlateBoundaryIndex.h"
+
+#include "planet.h"
+
+void PlateBoundaryIndex::rebuild(const Planet& planet) {
+    size_t N = planet.vertices.size();
+    foreignNeighbors.assign(N, 0);
+    slot.assign(N, noSlot);
+    boundaryVertices.clear();
+    sorted = true;
+    valid = true;
+
+    if (planet.verticesToPlates.size() != N || planet.neighbors.size() != N) return;
+
+    for (unsigned int v = 0; v < N; ++v) {
+        unsigned int myPlate = planet.verticesToPlates[v];
+        uint16_t count = 0;
+        for (unsigned int n : planet.neighbors[v]) {
+            if (planet.verticesToPlates[n] != myPlate) count++;
+        }
+        foreignNeighbors[v] = count;
+        if (count > 0) {
+            slot[v] = (unsigned int)boundaryVertices.size();
+            boundaryVertices.push_back(v);
+        }
+    }
+}
+
+void PlateBoundaryIndex::insert(unsigned int v) {
+    if (slot[v] != noSlot) return;
+    if (!boundaryVertices.empty() && boundaryVertices.back() > v) sorted = false;
+    slot[v] = (unsigned int)boundaryVertices.size();
+    boundaryVertices.push_back(v);
+}
+
+void PlateBoundaryIndex::erase(unsigned int v) {
+    unsigned int s = slot[v];
+    if (s == noSlot) return;
+    // échange avec le dernier : l'ordre est rétabli au prochain vertices()
+    unsigned int last = boundaryVertices.back();
+    boundaryVertices[s] = last;
+    slot[last] = s;
+    boundaryVertices.pop_back();
+    slot[v] = noSlot;
+    if (s != boundaryVertices.size()) sorted = false;
+}
+
+void PlateBoundaryIndex::onVertexPlateChange(const Planet& planet, unsigned int v, unsigned int newPlate) {
+    if (!valid) return;
+    unsigned int oldPlate = planet.verticesToPlates[v];
+    if (oldPlate == newPlate) return;
+
+    uint16_t count = 0;
+    for (unsigned int n : planet.neighbors[v]) {
+        unsigned int neighborPlate = planet.verticesToPlates[n];
+        bool wasForeign = neighborPlate != oldPlate;
+        bool isForeign = neighborPlate != newPlate;
+        if (isForeign) count++;
+        if (wasForeign == isForeign) continue;
+
+        if (isForeign) {
+            if (foreignNeighbors[n]++ == 0) insert(n);
+        } else {
+            if (--foreignNeighbors[n] == 0) erase(n);
+        }
+    }
+
+    foreignNeighbors[v] = count;
+    if (count > 0) insert(v);
+    else erase(v);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class Planet;
+
+// Index des frontières de plaques : seules les arêtes dont les deux extrémités sont sur
+// des plaques différentes peuvent produire des phénomènes. Pour chaque sommet on garde le
+// nombre de voisins sur une autre plaque ; les sommets frontière (compteur > 0) sont listés
+// par indice croissant, ce qui garde l'ordre de la boucle complète sur les sommets.
+// Les changements de plaque passent par Planet::setVertexPlate, qui met l'index à jour
+// localement (O(degré)) ; un nouveau maillage ou une nouvelle partition l'invalide.
+class PlateBoundaryIndex {
+   public:
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    void rebuild(const Planet& planet);
+
+    // À appeler avant d'écrire le nouveau numéro de plaque dans verticesToPlates
+    void onVertexPlateChange(const Planet& planet, unsigned int vertexIdx, unsigned int newPlate);
+
+    bool isBoundary(unsigned int vertexIdx) const {
+        return vertexIdx < foreignNeighbors.size() && foreignNeighbors[vertexIdx] > 0;
+    }
+
+    // Sommets frontière triés par indice
+    const std::vector<unsigned int>& vertices() const {
+        if (!sorted) {
+            std::sort(boundaryVertices.begin(), boundaryVertices.end());
+            for (size_t i = 0; i < boundaryVertices.size(); ++i) slot[boundaryVertices[i]] = (unsigned int)i;
+            sorted = true;
+        }
+        return boundaryVertices;
+    }
+
+    // Sous-intervalle [first, last) de vertices() pour les sommets d'indice dans [begin, end)
+    std::pair<size_t, size_t> range(unsigned int begin, unsigned int end) const {
+        const std::vector<unsigned int>& list = vertices();
+        size_t first = std::lower_bound(list.begin(), list.end(), begin) - list.begin();
+        size_t last = std::lower_bound(list.begin() + first, list.end(), end) - list.begin();
+        return std::make_pair(first, last);
+    }
+
+   private:
+    enum : unsigned int { noSlot = 0xffffffffu };
+
+    void insert(unsigned int v);
+    void erase(unsigned int v);
+
+    std::vector<uint16_t> foreignNeighbors;
+    mutable std::vector<unsigned int> boundaryVertices;
+    mutable std::vector<unsigned int> slot;
+    mutable bool sorted = true;
+    bool valid = false;
+};
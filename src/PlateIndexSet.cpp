@@ -0,0 +1,184 @@
+#include "PlateIndexSet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "planet.h"
+#include "Parallel.h"
+
+namespace {
+
+// Même normalisation que SphericalKDTree
+Vec3 normalized(const Vec3& p) {
+    float len = p.length();
+    return (len > 1e-12f) ? (p / len) : p;
+}
+
+}  // namespace
+
+bool PlateIndexSet::applicable(const Planet& planet) {
+    if (planet.plates.empty() || planet.verticesToPlates.size() != planet.vertices.size()) return false;
+    for (unsigned int p : planet.verticesToPlates) {
+        if (p >= planet.plates.size()) return false;
+    }
+    return true;
+}
+
+void PlateIndexSet::rebuild(const Planet& planet) {
+    size_t P = planet.plates.size();
+    indices.resize(P);
+    if (allDirty) {
+        for (PlateIndex& index : indices) index.dirty = true;
+    }
+
+    std::vector<unsigned int> dirtyPlates;
+    for (unsigned int p = 0; p < P; ++p) {
+        if (indices[p].dirty) dirtyPlates.push_back(p);
+    }
+
+    if (!dirtyPlates.empty()) {
+        std::vector<std::vector<uint32_t>> members(P);
+        if (planet.verticesToPlates.size() == planet.vertices.size()) {
+            for (unsigned int v = 0; v < planet.vertices.size(); ++v) {
+                unsigned int p = planet.verticesToPlates[v];
+                if (p < P && indices[p].dirty) members[p].push_back(v);
+            }
+        }
+
+        // Positions stockées : avec un repère en attente F, la position courante est F * stockée,
+        // la rotation depuis la construction part donc de l'identité
+        parallelFor(0, dirtyPlates.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t d = begin; d < end; ++d) {
+                unsigned int p = dirtyPlates[d];
+                PlateIndex& index = indices[p];
+                std::vector<Vec3> points(members[p].size());
+                Vec3 sum(0.0f, 0.0f, 0.0f);
+                for (size_t i = 0; i < points.size(); ++i) {
+                    points[i] = normalized(planet.vertices[members[p][i]]);
+                    sum += points[i];
+                }
+                index.capCenter = normalized(sum);
+                float radius2 = 0.0f;
+                for (const Vec3& point : points) radius2 = std::max(radius2, (point - index.capCenter).squareLength());
+                index.capRadius = std::sqrt(radius2) * 1.0001f + 1e-6f;
+
+                index.tree.build(points, members[p]);
+                index.motion = Quat();
+                index.dirty = false;
+            }
+        });
+    }
+
+    allDirty = false;
+    valid = true;
+}
+
+void PlateIndexSet::onVertexPlateChange(unsigned int oldPlate, unsigned int newPlate) {
+    if (oldPlate < indices.size()) indices[oldPlate].dirty = true;
+    if (newPlate < indices.size()) indices[newPlate].dirty = true;
+    valid = false;
+}
+
+void PlateIndexSet::applyFrames(const Planet& planet) {
+    size_t P = std::min(indices.size(), planet.plates.size());
+    for (size_t p = 0; p < P; ++p) {
+        const Plate& plate = planet.plates[p];
+        if (plate.frame.isIdentity()) continue;
+        indices[p].motion = plate.frame * indices[p].motion;
+        indices[p].motion.normalize();
+    }
+}
+
+Vec3 PlateIndexSet::toLocal(const Planet& planet, unsigned int p, const Vec3& q) const {
+    if (p >= planet.plates.size()) return q;
+    Quat toWorld = planet.plates[p].frame * indices[p].motion;
+    return toWorld.conjugate().rotate(q);
+}
+
+template <class AcceptPlate>
+unsigned int PlateIndexSet::search(const Planet& planet, const Vec3& q, unsigned int k, AcceptPlate acceptPlate,
+                                   FlatKDTree::Neighbor* out) const {
+    typedef FlatKDTree::Neighbor Neighbor;
+    k = std::min(k, (unsigned int)FlatKDTree::maxK);
+    if (k == 0) return 0;
+    Vec3 qn = normalized(q);
+
+    // Distance minimale possible de q à la calotte d'une plaque
+    auto gapTo = [&](unsigned int p, Vec3& local) {
+        local = toLocal(planet, p, qn);
+        return (local - indices[p].capCenter).length() - indices[p].capRadius;
+    };
+
+    // La plaque la plus proche d'abord, pour resserrer la borne au plus tôt
+    unsigned int first = noIndex;
+    float firstGap = std::numeric_limits<float>::max();
+    for (unsigned int p = 0; p < indices.size(); ++p) {
+        if (indices[p].tree.empty() || !acceptPlate(p)) continue;
+        Vec3 local;
+        float gap = gapTo(p, local);
+        if (gap < firstGap) {
+            firstGap = gap;
+            first = p;
+        }
+    }
+    if (first == noIndex) return 0;
+
+    unsigned int count = 0;
+    Neighbor part[FlatKDTree::maxK], merged[FlatKDTree::maxK];
+    for (unsigned int n = 0; n < indices.size(); ++n) {
+        unsigned int p = n == 0 ? first : (n <= first ? n - 1 : n);
+        if (indices[p].tree.empty() || !acceptPlate(p)) continue;
+
+        Vec3 local;
+        float gap = gapTo(p, local);
+        if (count == k && gap > 0.0f && gap * gap > out[k - 1].dist2) continue;
+
+        unsigned int found = indices[p].tree.kNearest(local, k, part);
+        unsigned int a = 0, b = 0, m = 0;
+        while (m < k && (a < count || b < found)) {
+            if (b == found || (a < count && out[a] < part[b])) merged[m++] = out[a++];
+            else merged[m++] = part[b++];
+        }
+        std::copy(merged, merged + m, out);
+        count = m;
+    }
+    return count;
+}
+
+uint32_t PlateIndexSet::nearest(const Planet& planet, const Vec3& q) const {
+    FlatKDTree::Neighbor result;
+    if (search(planet, q, 1, [](unsigned int) { return true; }, &result) == 0) return 0;
+    return result.id;
+}
+
+unsigned int PlateIndexSet::kNearest(const Planet& planet, const Vec3& q, unsigned int k,
+                                     FlatKDTree::Neighbor* out) const {
+    return search(planet, q, k, [](unsigned int) { return true; }, out);
+}
+
+std::pair<uint32_t, uint32_t> PlateIndexSet::nearestFromDifferentPlates(const Planet& planet, const Vec3& q) const {
+    FlatKDTree::Neighbor first, second;
+    if (search(planet, q, 1, [](unsigned int) { return true; }, &first) == 0) return {0, 1};
+    unsigned int firstPlate = planet.verticesToPlates[first.id];
+    if (search(planet, q, 1, [&](unsigned int p) { return p != firstPlate; }, &second) == 0) return {0, 1};
+    return {first.id, second.id};
+}
+
+void PlateIndexSet::nearestBatch(const Planet& planet, const Vec3* queries, size_t count, uint32_t* out) const {
+    parallelFor(0, count, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) out[i] = nearest(planet, queries[i]);
+    });
+}
+
+void PlateIndexSet::kNearestBatch(const Planet& planet, const Vec3* queries, size_t count, unsigned int k,
+                                  uint32_t* out) const {
+    parallelFor(0, count, 1024, [&](size_t begin, size_t end) {
+        FlatKDTree::Neighbor res[FlatKDTree::maxK];
+        for (size_t i = begin; i < end; ++i) {
+            unsigned int found = kNearest(planet, queries[i], k, res);
+            uint32_t* row = out + i * k;
+            for (unsigned int j = 0; j < k; ++j) row[j] = j < found ? res[j].id : noIndex;
+        }
+    });
+}
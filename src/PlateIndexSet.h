@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "FlatKDTree.h"
+#include "Vec3.h"
+
+class Planet;
+
+// Un index spatial (FlatKDTree) par plaque, construit dans le repère de la plaque.
+// Les plaques bougent rigidement : l'index reste valable tant que la plaque garde ses
+// sommets, seule la requête est ramenée dans le repère de construction (rotation inverse
+// du mouvement de la plaque depuis). Une requête parcourt les plaques candidates, écartées
+// par leur calotte englobante, et fusionne les résultats.
+// Les changements de plaque passent par Planet::setVertexPlate, qui marque les deux plaques
+// concernées : seules celles-ci sont reconstruites au prochain accès (rifting, migration,
+// nettoyage), les autres ne le sont plus jusqu'au prochain maillage.
+class PlateIndexSet {
+   public:
+    enum : uint32_t { noIndex = 0xffffffffu };
+
+    bool isValid() const { return valid; }
+    void invalidate() {
+        valid = false;
+        allDirty = true;
+    }
+    // Sommets tous affectés à une plaque
+    static bool applicable(const Planet& planet);
+
+    // Reconstruit les plaques marquées (toutes après invalidate)
+    void rebuild(const Planet& planet);
+
+    // À appeler avant d'écrire le nouveau numéro de plaque dans verticesToPlates
+    void onVertexPlateChange(unsigned int oldPlate, unsigned int newPlate);
+
+    // Appelée par Planet::materializePositions avant de remettre les repères à l'identité
+    void applyFrames(const Planet& planet);
+
+    // Requêtes en coordonnées courantes (repères en attente compris), points normalisés.
+    // Même départage que SphericalKDTree : à distance égale le plus petit indice gagne.
+    uint32_t nearest(const Planet& planet, const Vec3& q) const;
+    // k plus proches (k <= FlatKDTree::maxK), triés ; renvoie leur nombre
+    unsigned int kNearest(const Planet& planet, const Vec3& q, unsigned int k, FlatKDTree::Neighbor* out) const;
+    // (plus proche, plus proche sur une autre plaque que celle du premier)
+    std::pair<uint32_t, uint32_t> nearestFromDifferentPlates(const Planet& planet, const Vec3& q) const;
+
+    // Requêtes groupées, en parallèle (out préalloué ; stride k, noIndex au-delà)
+    void nearestBatch(const Planet& planet, const Vec3* queries, size_t count, uint32_t* out) const;
+    void kNearestBatch(const Planet& planet, const Vec3* queries, size_t count, unsigned int k, uint32_t* out) const;
+
+   private:
+    struct PlateIndex {
+        FlatKDTree tree;
+        Vec3 capCenter;          // calotte englobante, repère de construction
+        float capRadius = 0.0f;  // corde maximale depuis capCenter
+        Quat motion;             // rotation matérialisée depuis la construction
+        bool dirty = true;
+    };
+
+    // q (normalisé) ramené dans le repère de construction de la plaque p
+    Vec3 toLocal(const Planet& planet, unsigned int p, const Vec3& q) const;
+
+    // k plus proches parmi les plaques acceptées par acceptPlate(p)
+    template <class AcceptPlate>
+    unsigned int search(const Planet& planet, const Vec3& q, unsigned int k, AcceptPlate acceptPlate,
+                        FlatKDTree::Neighbor* out) const;
+
+    std::vector<PlateIndex> indices;
+    bool allDirty = true;
+    bool valid = false;
+};
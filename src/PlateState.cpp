@@ -0,0 +1,52 @@
+#include "PlateState.h"
+
+#include <cmath>
+
+#include "planet.h"
+#include "Parallel.h"
+
+void PlateStateTable::build(const Planet& planet) {
+    size_t P = planet.plates.size();
+    states.assign(P, PlateState());
+    relativeSpeeds.assign(P * P, 0.0f);
+    relativeRotations.assign(P * P, Vec3(0.0f, 0.0f, 0.0f));
+    if (P == 0) return;
+
+    // Les centroïdes viennent du tracker (reconstruit ici si besoin, hors section parallèle)
+    const CentroidTracker& tracker = planet.centroids();
+
+    parallelFor(0, P, 1, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            const Plate& plate = planet.plates[p];
+            PlateState& state = states[p];
+
+            // dans le cas ou collision entre 2 oceans le plus vieux plonge
+            float sumAge = 0.0f;
+            unsigned int count = 0;
+            for (unsigned int vidx : plate.vertices_indices) {
+                if (vidx >= planet.crust_data.size() || !planet.crust_data[vidx]) continue;
+                const Crust* crust = planet.crust_data[vidx].get();
+                if (crust->type != CrustType::Oceanic) continue;
+                sumAge += static_cast<const OceanicCrust*>(crust)->age;
+                if (++count >= maxAgeSamples) break;
+            }
+            state.meanOceanicAge = (count > 0) ? (sumAge / static_cast<float>(count)) : 0.0f;
+
+            Vec3 omega = plate.rotation_axis;
+            omega.normalize();
+            omega *= plate.plate_velocity;
+            state.angularVelocity = omega;
+
+            state.centroid = tracker.plateCentroid(planet, (unsigned int)p);
+        }
+    });
+
+    for (size_t a = 0; a < P; ++a) {
+        for (size_t b = 0; b < P; ++b) {
+            float v = std::abs(planet.plates[a].plate_velocity - planet.plates[b].plate_velocity);
+            if (v > planet.max_velocity) v = planet.max_velocity;
+            relativeSpeeds[a * P + b] = v;
+            relativeRotations[a * P + b] = states[a].angularVelocity - states[b].angularVelocity;
+        }
+    }
+}
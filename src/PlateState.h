@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include "Vec3.h"
+
+class Planet;
+
+// Propriétés d'une plaque figées pour un pas de simulation
+struct PlateState {
+    float meanOceanicAge = 0.0f;   // moyenne sur les premiers échantillons océaniques
+    Vec3 angularVelocity = Vec3(0.0f, 0.0f, 0.0f);  // axe normalisé * vitesse
+    Vec3 centroid = Vec3(0.0f, 0.0f, 0.0f);
+};
+
+// Table des PlateState reconstruite une fois par pas (en parallèle sur les plaques),
+// lue par la détection des phénomènes et par les événements au lieu de recalculer
+// ces valeurs à chaque paire de sommets frontière.
+class PlateStateTable {
+   public:
+    static const unsigned int maxAgeSamples = 50;
+
+    void build(const Planet& planet);
+
+    bool empty() const { return states.empty(); }
+    size_t size() const { return states.size(); }
+    const PlateState& operator[](unsigned int plateIdx) const { return states[plateIdx]; }
+
+    // |v_a - v_b| borné par max_velocity (même valeur que Planet::relativeVelocity)
+    float relativeSpeed(unsigned int plateA, unsigned int plateB) const {
+        return relativeSpeeds[plateA * states.size() + plateB];
+    }
+    // Rotation relative omega_a - omega_b (vitesse relative en p : omega_ab x p)
+    const Vec3& relativeRotation(unsigned int plateA, unsigned int plateB) const {
+        return relativeRotations[plateA * states.size() + plateB];
+    }
+
+   private:
+    std::vector<PlateState> states;
+    std::vector<float> relativeSpeeds;
+    std::vector<Vec3> relativeRotations;
+};
@@ -5,134 +5,461 @@
 #include <cmath>
 #include <utility>
 #include <limits>
+#include <map>
+#include <memory>
 
-#include "kdtree.h"
+#include "FlatKDTree.h"
+#include "NeighborCollectors.h"
 #include "Vec3.h"
+#include "Arena.h"
+#include "Parallel.h"
 #include "planet.h"
 
-using namespace Kdtree;
-
+// Index des plus proches voisins sur la sphère unité (points normalisés), au-dessus de
+// FlatKDTree. Les requêtes n'allouent pas (hors vecteur de sortie) et sont thread-safe.
 class SphericalKDTree {
 public:
-    SphericalKDTree(const std::vector<Vec3>& points, const Planet& /*planet*/) {
+    SphericalKDTree(const std::vector<Vec3>& points, const Planet& planet) {
         m_pointsNormalized.resize(points.size());
-        nodes.clear();
-        nodes.reserve(points.size());
         for (size_t i = 0; i < points.size(); ++i) {
-            const Vec3 &p = points[i];
-            float len = p.length();
-            Vec3 pn = (len > 1e-12f) ? (p / len) : p;
-            m_pointsNormalized[i] = pn;
-            CoordPoint cp(3);
-            cp[0] = pn[0];
-            cp[1] = pn[1];
-            cp[2] = pn[2];
-            nodes.emplace_back(cp, nullptr, static_cast<int>(i));
+            m_pointsNormalized[i] = normalized(points[i]);
         }
-        tree = new KdTree(&nodes, 2); // euclidean (squared)
-    }
+        tree.build(m_pointsNormalized);
 
-    ~SphericalKDTree() {
-        delete tree;
+        // Index secondaire : sommets frontière seulement, pour les requêtes entre plaques
+        if (planet.verticesToPlates.size() == points.size() && planet.neighbors.size() == points.size()) {
+            const std::vector<unsigned int>& boundary = planet.boundary().vertices();
+            std::vector<Vec3> boundaryPoints;
+            std::vector<uint32_t> boundaryIds;
+            boundaryPoints.reserve(boundary.size());
+            boundaryIds.reserve(boundary.size());
+            for (unsigned int v : boundary) {
+                boundaryPoints.push_back(m_pointsNormalized[v]);
+                boundaryIds.push_back(v);
+            }
+            boundaryTree.build(boundaryPoints, boundaryIds);
+        }
     }
 
     uint32_t nearest(const Vec3& q) const {
-        Vec3 qn;
-        float qlen = q.length();
-        if (qlen > 1e-12f) qn = q / qlen;
-        else qn = q;
-        CoordPoint cp = toCoord(qn);
-        KdNodeVector res;
-        tree->k_nearest_neighbors(cp, 1, &res);
-        if (res.empty()) return 0;
-        return static_cast<uint32_t>(res[0].index);
+        return tree.nearest(normalized(q));
     }
 
     std::vector<uint32_t> kNearest(const Vec3& q, unsigned int k = 8) const {
-        Vec3 qn;
-        float qlen = q.length();
-        if (qlen > 1e-12f) qn = q / qlen;
-        else qn = q;
-        CoordPoint cp = toCoord(qn);
-        KdNodeVector res;
-        tree->k_nearest_neighbors(cp, k, &res);
         std::vector<uint32_t> out;
-        out.reserve(res.size());
-        for (const auto &n : res) out.push_back(static_cast<uint32_t>(n.index));
+        kNearestInto(q, k, out);
         return out;
     }
 
+    // Variante sans allocation côté appelant : résultat dans un vecteur de l'arène
+    void kNearest(const Vec3& q, unsigned int k, ArenaVector<uint32_t>& out) const {
+        kNearestInto(q, k, out);
+    }
+
+    // Requêtes groupées : out[i] reçoit le plus proche de queries[i] (out préalloué, count cases)
+    void nearestBatch(const Vec3* queries, size_t count, uint32_t* out) const {
+        std::vector<uint32_t> order = coherentOrder(queries, count);
+        parallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+            FlatKDTree::WarmStart warm;
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t q = order[i];
+                out[q] = tree.nearest(normalized(queries[q]), &warm);
+            }
+        });
+    }
+
+    // out[i * k + j] : j-ème plus proche de queries[i] (out préalloué, count * k cases),
+    // noIndex au-delà des points disponibles. k borné par FlatKDTree::maxK
+    void kNearestBatch(const Vec3* queries, size_t count, unsigned int k, uint32_t* out) const {
+        std::vector<uint32_t> order = coherentOrder(queries, count);
+        parallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+            FlatKDTree::WarmStart warm;
+            FlatKDTree::Neighbor res[FlatKDTree::maxK];
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t q = order[i];
+                unsigned int found = tree.kNearest(normalized(queries[q]), k, res, &warm);
+                uint32_t* row = out + (size_t)q * k;
+                for (unsigned int j = 0; j < k; ++j) row[j] = j < found ? res[j].id : noIndex;
+            }
+        });
+    }
+
+    enum : uint32_t { noIndex = 0xffffffffu };
+
     // find two nearest vertices that belong to different plates
+    // (le plus proche, puis le plus proche sur une autre plaque)
     std::pair<uint32_t, uint32_t> nearestFromDifferentPlates(const Vec3& q, const Planet& planet) const {
-        Vec3 qn;
-        float qlen = q.length();
-        if (qlen > 1e-12f) qn = q / qlen;
-        else qn = q;
-        CoordPoint cp = toCoord(qn);
-
-        size_t total = nodes.size();
-        size_t k = std::min<size_t>(8, total ? total : 1);
-        while (k <= total) {
-            KdNodeVector res;
-            tree->k_nearest_neighbors(cp, k, &res);
-            // collect only valid plate-annotated indices sorted by distance
-            std::vector<uint32_t> candidates;
-            candidates.reserve(res.size());
-            for (const auto &n : res) {
-                uint32_t idx = static_cast<uint32_t>(n.index);
-                if (idx >= planet.verticesToPlates.size()) continue;
-                unsigned int p = planet.verticesToPlates[idx];
-                if (p >= planet.plates.size()) continue;
-                candidates.push_back(idx);
+        Vec3 qn = normalized(q);
+        size_t total = m_pointsNormalized.size();
+        if (planet.verticesToPlates.size() != total || total < 2) return {0, 1};
+
+        // seuls les sommets affectés à une plaque existante comptent
+        auto annotated = [&](uint32_t v) { return planet.verticesToPlates[v] < planet.plates.size(); };
+        FlatKDTree::Neighbor first;
+        if (!tree.nearestIf(qn, annotated, first)) return {0, 1};
+        unsigned int firstPlate = planet.verticesToPlates[first.id];
+
+        // Le plus proche sur une autre plaque est au bord de sa plaque : recherche bornée
+        // dans l'index des frontières, puis descente locale dans la plaque trouvée
+        if (!boundaryTree.empty()) {
+            uint32_t second = nearestOnOtherPlate(qn, firstPlate, planet);
+            if (second != std::numeric_limits<uint32_t>::max()) return {first.id, second};
+        }
+
+        // sans index des frontières : même recherche bornée sur l'arbre complet
+        FlatKDTree::Neighbor second;
+        auto otherPlate = [&](uint32_t v) { return annotated(v) && planet.verticesToPlates[v] != firstPlate; };
+        if (tree.nearestIf(qn, otherPlate, second)) return {first.id, second.id};
+        return {0, 1};
+    }
+
+private:
+    static Vec3 normalized(const Vec3& p) {
+        float len = p.length();
+        return (len > 1e-12f) ? (p / len) : p;
+    }
+
+    static const size_t batchGrain = 2048;
+
+    // Ordre de Morton des directions (10 bits par axe) : des requêtes consécutives tombent
+    // dans les mêmes branches de l'arbre et le départ à chaud reste pertinent
+    static std::vector<uint32_t> coherentOrder(const Vec3* queries, size_t count) {
+        std::vector<uint32_t> keys(count);
+        parallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Vec3 p = normalized(queries[i]);
+                uint32_t key = 0;
+                for (int d = 0; d < 3; ++d) {
+                    float t = std::min(std::max((p[d] + 1.0f) * 0.5f, 0.0f), 1.0f);
+                    key |= spreadBits((uint32_t)(t * 1023.0f)) << d;
+                }
+                keys[i] = key;
+            }
+        });
+
+        // tri par base (3 passes de 10 bits), stable : à clé égale l'ordre d'origine est gardé
+        std::vector<uint32_t> order(count), next(count);
+        for (size_t i = 0; i < count; ++i) order[i] = (uint32_t)i;
+        std::vector<uint32_t> histogram(1024);
+        for (int shift = 0; shift < 30; shift += 10) {
+            std::fill(histogram.begin(), histogram.end(), 0);
+            for (uint32_t q : order) histogram[(keys[q] >> shift) & 1023]++;
+            uint32_t offset = 0;
+            for (uint32_t& h : histogram) {
+                uint32_t c = h;
+                h = offset;
+                offset += c;
             }
-            if (candidates.size() >= 2) {
-                // find two with different plates (candidates are in ascending distance order)
-                for (size_t i = 0; i + 1 < candidates.size(); ++i) {
-                    unsigned int pi = planet.verticesToPlates[candidates[i]];
-                    for (size_t j = i + 1; j < candidates.size(); ++j) {
-                        unsigned int pj = planet.verticesToPlates[candidates[j]];
-                        if (pi != pj) return {candidates[i], candidates[j]};
+            for (uint32_t q : order) next[histogram[(keys[q] >> shift) & 1023]++] = q;
+            order.swap(next);
+        }
+        return order;
+    }
+
+    // 10 bits de x répartis tous les 3 bits
+    static uint32_t spreadBits(uint32_t x) {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8)) & 0x0300f00f;
+        x = (x | (x << 4)) & 0x030c30c3;
+        x = (x | (x << 2)) & 0x09249249;
+        return x;
+    }
+
+    // Quelques sommets frontière les plus proches, chacun affiné par descente locale dans sa
+    // plaque : le plus proche d'une plaque peut être un sommet juste derrière sa frontière
+    uint32_t nearestOnOtherPlate(const Vec3& qn, unsigned int excludedPlate, const Planet& planet) const {
+        static const unsigned int seeds = 4;
+        FlatKDTree::Neighbor res[seeds];
+        auto otherPlate = [&](uint32_t v) { return planet.verticesToPlates[v] != excludedPlate; };
+        unsigned int count = boundaryTree.kNearestIf(qn, seeds, otherPlate, res);
+
+        uint32_t best = std::numeric_limits<uint32_t>::max();
+        float bestDist2 = std::numeric_limits<float>::max();
+        for (unsigned int r = 0; r < count; ++r) {
+            uint32_t v = res[r].id;
+            unsigned int plate = planet.verticesToPlates[v];
+            float dist2 = (m_pointsNormalized[v] - qn).squareLength();
+            for (bool improved = true; improved;) {
+                improved = false;
+                for (unsigned int n : planet.neighbors[v]) {
+                    if (planet.verticesToPlates[n] != plate) continue;
+                    float d2 = (m_pointsNormalized[n] - qn).squareLength();
+                    if (d2 < dist2) {
+                        dist2 = d2;
+                        v = n;
+                        improved = true;
                     }
                 }
             }
-            if (k == total) break;
-            k = std::min<size_t>(k * 2, total);
+            if (dist2 < bestDist2) {
+                bestDist2 = dist2;
+                best = v;
+            }
         }
+        return best;
+    }
 
-        // fallback exhaustive search among annotated vertices
-        std::vector<std::pair<double,uint32_t>> all;
-        all.reserve(total);
-        for (size_t i = 0; i < m_pointsNormalized.size(); ++i) {
-            if (i >= planet.verticesToPlates.size()) continue;
-            unsigned int p = planet.verticesToPlates[i];
-            if (p >= planet.plates.size()) continue;
-            Vec3 d = m_pointsNormalized[i] - qn;
-            double d2 = d.squareLength();
-            all.emplace_back(d2, static_cast<uint32_t>(i));
-        }
-        if (all.size() >= 2) {
-            std::sort(all.begin(), all.end());
-            for (size_t i = 0; i + 1 < all.size(); ++i) {
-                unsigned int pi = planet.verticesToPlates[all[i].second];
-                for (size_t j = i + 1; j < all.size(); ++j) {
-                    unsigned int pj = planet.verticesToPlates[all[j].second];
-                    if (pi != pj) return {all[i].second, all[j].second};
+    // k borné par FlatKDTree::maxK
+    template <class Out>
+    void kNearestInto(const Vec3& q, unsigned int k, Out& out) const {
+        FlatKDTree::Neighbor res[FlatKDTree::maxK];
+        unsigned int count = tree.kNearest(normalized(q), k, res);
+        out.clear();
+        out.reserve(count);
+        for (unsigned int i = 0; i < count; ++i) out.push_back(res[i].id);
+    }
+
+    FlatKDTree tree;
+    FlatKDTree boundaryTree;  // sommets frontière (indices du maillage complet)
+    std::vector<Vec3> m_pointsNormalized;
+};
+
+// Géométrie d'une grille cube-sphère de 6 x M x M cellules : projection sur la face du
+// cube de plus grande composante, coordonnées de face redressées par atan (cellules de
+// surfaces voisines). Ne dépend que de M : partagée par toutes les grilles de même taille.
+struct CubeSphereCells {
+    unsigned int M;
+    std::vector<Vec3> centers;               // centre de chaque cellule (normalisé)
+    std::vector<float> radius;               // corde maximale du centre aux coins
+    std::vector<uint32_t> adjacency;         // 8 cellules voisines (faces voisines comprises)
+
+    explicit CubeSphereCells(unsigned int m) : M(m) {
+        size_t C = 6 * (size_t)M * M;
+        centers.resize(C);
+        radius.resize(C);
+        adjacency.resize(C * 8);
+        float h = 2.0f / M;
+        for (unsigned int f = 0; f < 6; ++f) {
+            for (unsigned int i = 0; i < M; ++i) {
+                for (unsigned int j = 0; j < M; ++j) {
+                    size_t c = ((size_t)f * M + i) * M + j;
+                    float a = -1.0f + (i + 0.5f) * h, b = -1.0f + (j + 0.5f) * h;
+                    centers[c] = direction(f, a, b);
+                    float r2 = 0.0f;
+                    for (int corner = 0; corner < 4; ++corner) {
+                        Vec3 p = direction(f, a + ((corner & 1) ? 0.5f : -0.5f) * h, b + ((corner & 2) ? 0.5f : -0.5f) * h);
+                        r2 = std::max(r2, (p - centers[c]).squareLength());
+                    }
+                    radius[c] = std::sqrt(r2) * 1.001f + 1e-6f;
+                    // voisins : centres décalés d'une cellule, prolongés au-delà de la face si besoin
+                    unsigned int k = 0;
+                    for (int di = -1; di <= 1; ++di) {
+                        for (int dj = -1; dj <= 1; ++dj) {
+                            if (di == 0 && dj == 0) continue;
+                            adjacency[c * 8 + k++] = cellOf(direction(f, a + di * h, b + dj * h));
+                        }
+                    }
                 }
             }
         }
-        return {0, 1};
+    }
+
+    // Cellule d'une direction unitaire
+    uint32_t cellOf(const Vec3& p) const {
+        float ax = std::abs(p[0]), ay = std::abs(p[1]), az = std::abs(p[2]);
+        unsigned int f;
+        float u, v, major;
+        if (ax >= ay && ax >= az) {
+            f = p[0] >= 0.0f ? 0 : 1;
+            major = ax;
+            u = p[1];
+            v = p[2];
+        } else if (ay >= az) {
+            f = p[1] >= 0.0f ? 2 : 3;
+            major = ay;
+            u = p[2];
+            v = p[0];
+        } else {
+            f = p[2] >= 0.0f ? 4 : 5;
+            major = az;
+            u = p[0];
+            v = p[1];
+        }
+        if (major <= 0.0f) return 0;
+        const float warp = 4.0f / (float)M_PI;
+        float a = std::atan(u / major) * warp, b = std::atan(v / major) * warp;
+        unsigned int i = std::min((unsigned int)std::max((a + 1.0f) * 0.5f * M, 0.0f), M - 1);
+        unsigned int j = std::min((unsigned int)std::max((b + 1.0f) * 0.5f * M, 0.0f), M - 1);
+        return ((uint32_t)f * M + i) * M + j;
+    }
+
+    // Direction des coordonnées redressées (a, b) de la face f (a, b hors de [-1, 1] : prolongement)
+    static Vec3 direction(unsigned int f, float a, float b) {
+        const float quarter = (float)M_PI / 4.0f;
+        float u = std::tan(std::max(-1.9f, std::min(1.9f, a)) * quarter);
+        float v = std::tan(std::max(-1.9f, std::min(1.9f, b)) * quarter);
+        float s = (f & 1) ? -1.0f : 1.0f;
+        Vec3 p;
+        if (f < 2) p = Vec3(s, u, v);
+        else if (f < 4) p = Vec3(v, s, u);
+        else p = Vec3(u, v, s);
+        return p / p.length();
+    }
+
+    // Géométrie partagée par taille (construite une fois, depuis le thread principal)
+    static std::shared_ptr<const CubeSphereCells> forSize(unsigned int m) {
+        static std::map<unsigned int, std::shared_ptr<const CubeSphereCells>> cache;
+        auto it = cache.find(m);
+        if (it != cache.end()) return it->second;
+        std::shared_ptr<const CubeSphereCells> cells = std::make_shared<CubeSphereCells>(m);
+        cache[m] = cells;
+        return cells;
+    }
+};
+
+// Grille de seaux cube-sphère sur la sphère unité (points normalisés), stockage compressé
+// par cellule. Environ pointsPerCell points par cellule : plus proche, k plus proches et
+// requêtes à rayon fixe en O(1) attendu, en parcourant les cellules par voisinage tant que
+// leur distance minimale possible reste sous la borne courante. Construction par tri par
+// comptage en O(N), en parallèle : assez légère pour être refaite à chaque pas.
+// À distance égale le plus petit indice gagne, comme SphericalKDTree.
+class SphericalGrid {
+public:
+    static const unsigned int pointsPerCell = 2;
+    enum : uint32_t { noIndex = 0xffffffffu };
+
+    SphericalGrid() {}
+    explicit SphericalGrid(const std::vector<Vec3>& points) { build(points); }
+
+    void build(const std::vector<Vec3>& points) {
+        size_t n = points.size();
+        unsigned int M = (unsigned int)std::max(1.0, std::round(std::sqrt((double)n / (6.0 * pointsPerCell))));
+        cells = CubeSphereCells::forSize(M);
+        size_t C = cells->centers.size();
+
+        // Comptage par bloc, puis décalages cellule par cellule dans l'ordre des blocs :
+        // le rangement (indice croissant dans chaque cellule) ne dépend pas des threads
+        const size_t chunkSize = 16384;
+        size_t nChunks = std::max<size_t>(1, (n + chunkSize - 1) / chunkSize);
+        std::vector<uint32_t> cellIndex(n);
+        std::vector<uint32_t> counts(nChunks * C, 0);
+        parallelChunks(n, chunkSize, [&](size_t chunk, size_t begin, size_t end) {
+            uint32_t* count = &counts[chunk * C];
+            for (size_t i = begin; i < end; ++i) {
+                cellIndex[i] = cells->cellOf(normalized(points[i]));
+                count[cellIndex[i]]++;
+            }
+        });
+
+        cellOffsets.resize(C + 1);
+        uint32_t running = 0;
+        for (size_t c = 0; c < C; ++c) {
+            cellOffsets[c] = running;
+            for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+                uint32_t count = counts[chunk * C + c];
+                counts[chunk * C + c] = running;
+                running += count;
+            }
+        }
+        cellOffsets[C] = running;
+
+        pointIds.resize(n);
+        positions.resize(n);
+        parallelChunks(n, chunkSize, [&](size_t chunk, size_t begin, size_t end) {
+            uint32_t* slot = &counts[chunk * C];
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t s = slot[cellIndex[i]]++;
+                pointIds[s] = (uint32_t)i;
+                positions[s] = normalized(points[i]);
+            }
+        });
+    }
+
+    size_t size() const { return pointIds.size(); }
+
+    uint32_t nearest(const Vec3& q) const {
+        NearestCollector collector(1);
+        explore(normalized(q), collector);
+        return collector.count > 0 ? collector.items[0].id : 0;
+    }
+
+    std::vector<uint32_t> kNearest(const Vec3& q, unsigned int k = 8) const {
+        std::vector<uint32_t> out;
+        kNearestInto(q, k, out);
+        return out;
+    }
+
+    void kNearest(const Vec3& q, unsigned int k, ArenaVector<uint32_t>& out) const {
+        kNearestInto(q, k, out);
+    }
+
+    // Points à une corde au plus radius de q (sphère unité), dans l'ordre des cellules
+    void withinRadius(const Vec3& q, float radius, std::vector<uint32_t>& out) const {
+        out.clear();
+        RadiusCollector collector{radius * radius, out};
+        explore(normalized(q), collector);
+    }
+
+    // out[i] : plus proche de queries[i] (out préalloué)
+    void nearestBatch(const Vec3* queries, size_t count, uint32_t* out) const {
+        parallelFor(0, count, 2048, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) out[i] = nearest(queries[i]);
+        });
     }
 
 private:
-    CoordPoint toCoord(const Vec3& v) const {
-        CoordPoint cp(3);
-        cp[0] = v[0];
-        cp[1] = v[1];
-        cp[2] = v[2];
-        return cp;
+    struct RadiusCollector {
+        float radius2;
+        std::vector<uint32_t>& out;
+        float bound() const { return radius2; }
+        void offer(float dist2, uint32_t id) {
+            if (dist2 <= radius2) out.push_back(id);
+        }
+    };
+
+    // Marques de visite des cellules, une par thread
+    static VisitMarks& threadMarks() {
+        thread_local VisitMarks marks;
+        return marks;
     }
 
-    KdTree* tree = nullptr;
-    KdNodeVector nodes;
-    std::vector<Vec3> m_pointsNormalized;
-};
\ No newline at end of file
+    // Parcours des cellules depuis celle de q ; une cellule est ouverte si sa distance
+    // minimale possible à q (centre moins rayon) ne dépasse pas la borne. Les cellules qui
+    // touchent la boule forment une région connexe, toutes sont donc atteintes.
+    template <class Collector>
+    void explore(const Vec3& q, Collector& collector) const {
+        if (pointIds.empty()) return;
+        VisitMarks& marks = threadMarks();
+        marks.begin(cells->centers.size());
+        marks.visit(cells->cellOf(q));
+
+        for (size_t head = 0; head < marks.queue.size(); ++head) {
+            uint32_t c = marks.queue[head];
+            for (uint32_t s = cellOffsets[c]; s < cellOffsets[c + 1]; ++s) {
+                const Vec3& p = positions[s];
+                float dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+                collector.offer(dx * dx + dy * dy + dz * dz, pointIds[s]);
+            }
+            for (unsigned int k = 0; k < 8; ++k) {
+                uint32_t n = cells->adjacency[c * 8 + k];
+                if (marks.stamp[n] == marks.current) continue;
+                float bound = collector.bound();
+                if (bound != std::numeric_limits<float>::max()) {
+                    float gap = (cells->centers[n] - q).length() - cells->radius[n];
+                    if (gap > 0.0f && gap * gap > bound) continue;
+                }
+                marks.visit(n);
+            }
+        }
+    }
+
+    template <class Out>
+    void kNearestInto(const Vec3& q, unsigned int k, Out& out) const {
+        NearestCollector collector(k);
+        explore(normalized(q), collector);
+        out.clear();
+        out.reserve(collector.count);
+        for (unsigned int i = 0; i < collector.count; ++i) out.push_back(collector.items[i].id);
+    }
+
+    static Vec3 normalized(const Vec3& p) {
+        float len = p.length();
+        return (len > 1e-12f) ? (p / len) : p;
+    }
+
+    std::shared_ptr<const CubeSphereCells> cells;
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> pointIds;   // indices des points, rangés par cellule
+    std::vector<Vec3> positions;      // positions normalisées, même ordre
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+
+// Profils de soulèvement tabulés à la compilation (constexpr), échantillonnés par
+// interpolation linéaire. Les événements évaluent les zones par lots (cf. les noyaux
+// *UpliftBatch de subduction.cpp et continentalCollision.cpp).
+
+template <unsigned int N>
+struct ProfileTable {
+    float values[N + 1];  // N intervalles, extrémités incluses
+
+    // t dans [0, 1], borné
+    float sample(float t) const {
+        float x = t * (float)N;
+        if (!(x > 0.0f)) return values[0];
+        if (x >= (float)N) return values[N];
+        unsigned int i = (unsigned int)x;
+        float w = x - (float)i;
+        return values[i] + w * (values[i + 1] - values[i]);
+    }
+};
+
+// Racine carrée évaluable à la compilation (std::sqrt ne l'est pas en C++14)
+constexpr double constexprSqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; ++i) r = 0.5 * (r + x / r);
+    return r;
+}
+
+// f(d) = 1 - 3x^2 + 2x^3 avec x = d / r_s, tabulée en s = x^2 : pas de racine carrée à l'évaluation
+template <unsigned int N>
+constexpr ProfileTable<N> makeFalloffTable() {
+    ProfileTable<N> table{};
+    for (unsigned int i = 0; i <= N; ++i) {
+        double s = (double)i / N;
+        table.values[i] = (float)(1.0 - 3.0 * s + 2.0 * s * constexprSqrt(s));
+    }
+    return table;
+}
+
+// Atténuation par bande d'élévation : < 2000, >= 2000, >= 4000, >= 6000 m
+struct DampingBands {
+    float factor[4];
+
+    float operator()(float elevation) const {
+        int band = (elevation >= 2000.0f) + (elevation >= 4000.0f) + (elevation >= 6000.0f);
+        return factor[band];
+    }
+};
+
+struct UpliftProfiles {
+    static const unsigned int falloffResolution = 1024;
+
+    // f(d) pour d^2 / r_s^2 ; vaut 0 au-delà de r_s
+    static float falloffSq(float normalizedDistSq) {
+        static constexpr ProfileTable<falloffResolution> table = makeFalloffTable<falloffResolution>();
+        return table.sample(normalizedDistSq);
+    }
+
+    // Élévation normalisée dans [0, 1], sans branche
+    static float elevationImpact(float z, float minZ, float maxZ) {
+        if (maxZ <= minZ) return 0.0f;
+        float normalizedZ = (z - minZ) / (maxZ - minZ);
+        return normalizedZ < 0.0f ? 0.0f : (normalizedZ > 1.0f ? 1.0f : normalizedZ);
+    }
+
+    // Noyaux par lots
+    static void falloffBatch(const float* distSq, size_t n, float invRadiusSq, float* out) {
+        for (size_t i = 0; i < n; ++i) out[i] = falloffSq(distSq[i] * invRadiusSq);
+    }
+
+    // out[i] *= atténuation de la bande de elevation[i]
+    static void dampingBatch(const DampingBands& bands, const float* elevation, size_t n, float* out) {
+        for (size_t i = 0; i < n; ++i) out[i] *= bands(elevation[i]);
+    }
+};
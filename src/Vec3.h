@@ -565,6 +565,52 @@ Mat3 operator * (float s , const Mat3 & m)
 }
 
 
+// Quaternion unitaire (w, x, y, z) pour composer des rotations rigides sans dérive
+class Quat {
+public:
+    float w , x , y , z;
+
+    Quat() : w(1.f) , x(0.f) , y(0.f) , z(0.f) {}
+    Quat( float w_ , float x_ , float y_ , float z_ ) : w(w_) , x(x_) , y(y_) , z(z_) {}
+
+    static Quat fromAxisAndAngle( Vec3 axis , float angle ) {
+        axis.normalize();
+        float s = std::sin( 0.5f * angle );
+        return Quat( std::cos( 0.5f * angle ) , axis[0] * s , axis[1] * s , axis[2] * s );
+    }
+
+    // (a * b) applique d'abord b puis a
+    Quat operator * ( const Quat & q ) const {
+        return Quat( w*q.w - x*q.x - y*q.y - z*q.z ,
+                     w*q.x + x*q.w + y*q.z - z*q.y ,
+                     w*q.y - x*q.z + y*q.w + z*q.x ,
+                     w*q.z + x*q.y - y*q.x + z*q.w );
+    }
+
+    Quat conjugate() const { return Quat( w , -x , -y , -z ); }
+
+    void normalize() {
+        float n = std::sqrt( w*w + x*x + y*y + z*z );
+        if( n > 0.f ) { w /= n; x /= n; y /= n; z /= n; }
+    }
+
+    bool isIdentity() const { return x == 0.f && y == 0.f && z == 0.f; }
+
+    Mat3 toMat3() const {
+        return Mat3( 1.f - 2.f*(y*y + z*z) , 2.f*(x*y - w*z) , 2.f*(x*z + w*y) ,
+                     2.f*(x*y + w*z) , 1.f - 2.f*(x*x + z*z) , 2.f*(y*z - w*x) ,
+                     2.f*(x*z - w*y) , 2.f*(y*z + w*x) , 1.f - 2.f*(x*x + y*y) );
+    }
+
+    Vec3 rotate( const Vec3 & p ) const {
+        // p + 2w(u x p) + 2 u x (u x p)
+        Vec3 u( x , y , z );
+        Vec3 t = 2.f * Vec3::cross( u , p );
+        return p + w * t + Vec3::cross( u , t );
+    }
+};
+
+
 inline static std::ostream & operator << (std::ostream & s , Mat3 const & m)
 {
     s << m(0,0) << " \t" << m(0,1) << " \t" << m(0,2) << std::endl << m(1,0) << " \t" << m(1,1) << " \t" << m(1,2) << std::endl << m(2,0) << " \t" << m(2,1) << " \t" << m(2,2) << std::endl;
@@ -17,9 +17,9 @@ public:
     FastNoiseLite general_noise;
     FastNoiseLite ground_noise;
     FastNoiseLite mountain_noise;
-    SphericalKDTree accel;
+    SphericalGrid accel;
     
-    Amplification(Planet & p) : accel(p.vertices, p) {
+    Amplification(Planet & p) : accel(p.vertices) {
         general_noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
         general_noise.SetFrequency(2.0 * (float) amplification_quality);
         general_noise.SetFractalType(FastNoiseLite::FractalType_FBm);
@@ -47,10 +47,14 @@ public:
     
 
 void amplifyTerrain(Planet& planet) {
+    planet.materializePositions();
     Planet newPlanet(1.0f, planet.vertices.size() * amplification_quality);
 
+    std::vector<uint32_t> closest(newPlanet.vertices.size());
+    accel.nearestBatch(newPlanet.vertices.data(), newPlanet.vertices.size(), closest.data());
+
     for (int vertexIdx = 0; vertexIdx < newPlanet.vertices.size(); vertexIdx++) {
-        newPlanet.vertices[vertexIdx] = copyClosestVertex(planet, newPlanet, vertexIdx);
+        newPlanet.vertices[vertexIdx] = copyClosestVertex(planet, newPlanet, vertexIdx, closest[vertexIdx]);
     }
     newPlanet.detectVerticesNeighbors();
     planet = std::move(newPlanet);
@@ -66,9 +70,8 @@ void amplifyTerrain(Planet& planet) {
 }
 
 private:
-    Vec3 copyClosestVertex(Planet& planet, Planet& newPlanet, unsigned int vertexIdx) {
+    Vec3 copyClosestVertex(Planet& planet, Planet& newPlanet, unsigned int vertexIdx, unsigned int closestVertexIdx) {
         Vec3 vertexPosition = newPlanet.vertices[vertexIdx];
-        unsigned int closestVertexIdx = accel.nearest(vertexPosition);
 
         float crust_elevation = planet.crust_data[closestVertexIdx]->relief_elevation;
         float normalized_elevation = (crust_elevation - planet.min_elevation) / (planet.max_elevation - planet.min_elevation);
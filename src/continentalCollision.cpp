@@ -8,100 +8,93 @@
 #include "tectonicPhenomenon.h"
 #include "planet.h"
 #include "crust.h"
+#include "UpliftProfiles.h"
 
 const float COLLISION_RADIUS = 0.35f;        // Rayon d'influence de la collision
 const float MOUNTAIN_HEIGHT = 6000.0f;      // Hauteur des montagnes créées (en mètres)
 const float MOUNTAIN_WIDTH = 0.01f;         // Largeur de la zone de montagne
-const float SMOOTHNESS = 5.0f;
 
 float continentalCollisionUplift = 5000.0f;   // por ejemplo
 
 
-float smoothMountainProfile(float distance, float width, float smoothness){
-    if (distance >= width) return 0.0f;
+// Atténuation selon l'élévation du sommet soulevé (< 2000, >= 2000, >= 4000, >= 6000 m)
+static const DampingBands collisionDampingA = {{1.0f, 0.4f, 0.5f, 0.1f}};
+static const DampingBands collisionDampingB = {{1.0f, 0.4f, 0.2f, 0.1f}};
 
-    float normalizedDist = distance / width;
-    float cosineFactor = (std::cos(normalizedDist * M_PI) + 1.0f) * 0.5f;
-    float expFactor = std::exp(-smoothness * normalizedDist * normalizedDist);
-    return 0.3f * cosineFactor + 0.7f * expFactor;
-};
 
+void continentalCollisionUpliftBatch(const float* distSq, const float* elevation, size_t n,
+                                     float v, float minZ, float maxZ,
+                                     const DampingBands& damping, float* uplift) {
+    typedef TectonicPhenomenon P;
+    UpliftProfiles::falloffBatch(distSq, n, 1.0f / (P::r_s * P::r_s), uplift);
+    float speed = P::g(v);
+    for (size_t i = 0; i < n; ++i) {
+        float z = UpliftProfiles::elevationImpact(elevation[i], minZ, maxZ);
+        uplift[i] = continentalCollisionUplift * uplift[i] * speed * P::h(z);
+    }
+    UpliftProfiles::dampingBatch(damping, elevation, n, uplift);
+}
 
-void ContinentalCollision::triggerEvent(Planet& planet) {
-    float minZ = planet.min_elevation;
-    float maxZ = planet.max_elevation;
 
-    Plate& plateA = planet.plates[plate_a];
-    Plate& plateB = planet.plates[plate_b];
+// Soulève la zone d'une plaque autour du sommet de collision, par lots ; la distance au
+// front est lue dans le champ de distance aux frontières
+static void collisionZoneUplift(const std::vector<unsigned int>& zone,
+                                float v, const DampingBands& damping,
+                                const Planet& planet, UpliftBuffer& uplift) {
+    const BoundaryDistanceField& field = planet.boundaryDistances();
+    unsigned int indices[upliftBatchSize];
+    float distSq[upliftBatchSize];
+    float elevation[upliftBatchSize];
+    float newElevation[upliftBatchSize];
+
+    for (size_t begin = 0; begin < zone.size(); begin += upliftBatchSize) {
+        size_t n = std::min(zone.size() - begin, upliftBatchSize);
+        for (size_t i = 0; i < n; ++i) {
+            unsigned int vertexIndex = zone[begin + i];
+            indices[i] = vertexIndex;
+            float d = field.distance(vertexIndex);
+            distSq[i] = d * d;
+            elevation[i] = planet.crust_data[vertexIndex]->relief_elevation;
+        }
+        continentalCollisionUpliftBatch(distSq, elevation, n, v, planet.min_elevation, planet.max_elevation,
+                                        damping, newElevation);
+        for (size_t i = 0; i < n; ++i) uplift.push_back(UpliftDelta{indices[i], newElevation[i], false});
+    }
+}
 
-    unsigned int phenomenonVertexIndex = getVertexIndex();
-    Vec3 collisionVertex = planet.vertices[phenomenonVertexIndex];
 
-    std::vector<unsigned int> verticesA =
-        plateA.closestFrontierVertices[phenomenonVertexIndex];
+void evaluateContinentalCollision(const BoundarySegment& segment, unsigned int phenomenonVertexIndex,
+                                  const Planet& planet, UpliftBuffer& uplift) {
+    unsigned int plate_a = segment.summary.plate_a;
+    unsigned int plate_b = segment.summary.plate_b;
 
-    std::vector<unsigned int> verticesB =
-        plateB.closestFrontierVertices[phenomenonVertexIndex];
+    const Plate& plateA = planet.plates[plate_a];
+    const Plate& plateB = planet.plates[plate_b];
 
-    float v = planet.relativeVelocity(plateA, plateB);
+    float v = planet.plateRelativeSpeed(plate_a, plate_b);
 
     //
     // --- PROCESAR VÉRTICES DE LA PLACA A ---
     //
-    for (unsigned int vertexIndex : verticesA) {
-
-        Vec3 vertex = planet.vertices[vertexIndex];
-        float d = distanceToInteractionFront(vertex, collisionVertex);
-
-        float z = elevationImpact(
-            planet.crust_data[vertexIndex]->relief_elevation,
-            minZ, maxZ
-        );
-
-        float newElevation = continentalCollisionUplift * f(d) * g(v) * h(z);
-
-        if (planet.crust_data[vertexIndex]->relief_elevation >= 6000.0f)
-            newElevation *= 0.1f;
-        else if (planet.crust_data[vertexIndex]->relief_elevation >= 4000.0f)
-            newElevation *= 0.5f;
-        else if (planet.crust_data[vertexIndex]->relief_elevation >= 2000.0f)
-            newElevation *= 0.4f;
-
-        planet.crust_data[vertexIndex]->relief_elevation += newElevation;
+    auto zoneA = plateA.closestFrontierVertices.find(phenomenonVertexIndex);
+    if (zoneA != plateA.closestFrontierVertices.end()) {
+        collisionZoneUplift(zoneA->second, v, collisionDampingA, planet, uplift);
     }
 
-
     //
     // --- PROCESAR VÉRTICES DE LA PLACA B ---
     //
-    for (unsigned int vertexIndex : verticesB) {
-
-        Vec3 vertex = planet.vertices[vertexIndex];
-        float d = distanceToInteractionFront(vertex, collisionVertex);
-
-        float z = elevationImpact(
-            planet.crust_data[vertexIndex]->relief_elevation,
-            minZ, maxZ
-        );
-
-        float newElevation = continentalCollisionUplift * f(d) * g(v) * h(z);
-
-        if (planet.crust_data[vertexIndex]->relief_elevation >= 6000.0f)
-            newElevation *= 0.1f;
-        else if (planet.crust_data[vertexIndex]->relief_elevation >= 4000.0f)
-            newElevation *= 0.2f;
-        else if (planet.crust_data[vertexIndex]->relief_elevation >= 2000.0f)
-            newElevation *= 0.4f;
-
-        planet.crust_data[vertexIndex]->relief_elevation += newElevation;
+    auto zoneB = plateB.closestFrontierVertices.find(phenomenonVertexIndex);
+    if (zoneB != plateB.closestFrontierVertices.end()) {
+        collisionZoneUplift(zoneB->second, v, collisionDampingB, planet, uplift);
     }
 }
 
-// void ContinentalCollision::triggerEvent(Planet& planet) {
-void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
-    unsigned int collisionVertex = getVertexIndex();
-    unsigned int plateAIdx = getPlateA();
-    unsigned int plateBIdx = getPlateB();
+// void triggerContinentalCollision(const TectonicPhenomenon& phenomenon, Planet& planet) {
+void triggerTerranesMigration(const TectonicPhenomenon& phenomenon, Planet& planet) {
+    unsigned int collisionVertex = phenomenon.getVertexIndex();
+    unsigned int plateAIdx = phenomenon.getPlateA();
+    unsigned int plateBIdx = phenomenon.getPlateB();
 
     if (collisionVertex >= planet.vertices.size()) return;
     if (plateAIdx >= planet.plates.size() || plateBIdx >= planet.plates.size()) return;
@@ -111,6 +104,10 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
 
     Vec3 collisionPoint = planet.vertices[collisionVertex];
 
+    // centroïdes suivis incrémentalement (cf. CentroidTracker)
+    planet.centroids();
+    CentroidTracker& tracker = planet.centroidTracker;
+
     // -----------------------------------------------
     // 1. Buscar terrane más cercano de A y B
     // -----------------------------------------------
@@ -125,7 +122,7 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     for (size_t i = 0; i < plateA.terranes.size(); ++i) {
         if (plateA.terranes[i].empty()) continue;
 
-        float dist = (collisionPoint - plateA.terraneCentroids[i]).length();
+        float dist = (collisionPoint - tracker.terraneCentroid(planet, plateAIdx, i)).length();
         if (dist < minDistA) {
             minDistA = dist;
             terraneA_idx = i;
@@ -136,7 +133,7 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     for (size_t i = 0; i < plateB.terranes.size(); ++i) {
         if (plateB.terranes[i].empty()) continue;
 
-        float dist = (collisionPoint - plateB.terraneCentroids[i]).length();
+        float dist = (collisionPoint - tracker.terraneCentroid(planet, plateBIdx, i)).length();
         if (dist < minDistB) {
             minDistB = dist;
             terraneB_idx = i;
@@ -149,9 +146,6 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     std::vector<unsigned int>& terraneA = plateA.terranes[terraneA_idx];
     std::vector<unsigned int>& terraneB = plateB.terranes[terraneB_idx];
 
-    Vec3 centroidA = plateA.terraneCentroids[terraneA_idx];
-    Vec3 centroidB = plateB.terraneCentroids[terraneB_idx];
-
     // -----------------------------------------------
     // 2. Ganador = terrane más grande
     // -----------------------------------------------
@@ -198,7 +192,7 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     
     // Actualizar ownership
     for (unsigned int vIdx : verticesToTransfer)
-        planet.verticesToPlates[vIdx] = winningPlateIdx;
+        planet.setVertexPlate(vIdx, winningPlateIdx);
 
     // Quitar de la placa perdedora
     losingPlate.vertices_indices.erase(
@@ -228,21 +222,15 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     );
 
     // -----------------------------------------------
-    // 5. Actualizar centroides
+    // 5. Actualizar centroides (incremental)
     // -----------------------------------------------
 
-    Vec3 newWinCentroid(0,0,0);
-    for (unsigned int vIdx : winningTerrane)
-        newWinCentroid += planet.vertices[vIdx];
-
-    newWinCentroid /= (float)winningTerrane.size();
-    newWinCentroid.normalize();
-    newWinCentroid *= planet.radius;
+    tracker.transferVertices(planet, verticesToTransfer,
+                             losingPlateIdx, losingTerraneIdx,
+                             winningPlateIdx, winningTerraneIdx);
 
-    if (terraneA_wins)
-        plateA.terraneCentroids[winningTerraneIdx] = newWinCentroid;
-    else
-        plateB.terraneCentroids[winningTerraneIdx] = newWinCentroid;
+    // Frontières et zones d'influence autour des sommets transférés
+    planet.updateFrontierInfluence();
 
     // Reducir terrane perdedor
     losingTerrane.erase(
@@ -257,20 +245,6 @@ void ContinentalCollision::triggerTerranesMigration(Planet& planet) {
     // Si queda vacío → eliminar
     if (losingTerrane.empty()) {
         losingPlate.terranes.erase(losingPlate.terranes.begin() + losingTerraneIdx);
-        losingPlate.terraneCentroids.erase(losingPlate.terraneCentroids.begin() + losingTerraneIdx);
-    } else {
-        // Recalcular centroide del perdedor
-        Vec3 newLoseCentroid(0,0,0);
-        for (unsigned int vIdx : losingTerrane)
-            newLoseCentroid += planet.vertices[vIdx];
-
-        newLoseCentroid /= (float)losingTerrane.size();
-        newLoseCentroid.normalize();
-        newLoseCentroid *= planet.radius;
-
-        if (terraneA_wins)
-            plateB.terraneCentroids[losingTerraneIdx] = newLoseCentroid;
-        else
-            plateA.terraneCentroids[losingTerraneIdx] = newLoseCentroid;
+        tracker.eraseTerrane(losingPlateIdx, losingTerraneIdx);
     }
 }
\ No newline at end of file
@@ -5,18 +5,20 @@
 #include "planet.h"
 #include "crust.h"
 
-void crustGeneration::triggerEvent(Planet& planet) {
+void triggerCrustGeneration(const TectonicPhenomenon& phenomenon, Planet& planet,
+                            Vec3 q, Vec3 closestPlateBoundary) {
 
     if (q.length() == 0) {
         return; // not clean
     }
 
-    unsigned int vertexIndex = getVertexIndex();
+    unsigned int vertexIndex = phenomenon.getVertexIndex();
+    float divergence = phenomenon.getDivergence();
     
     //std::cout << "crustGeneration event triggered at vertex " << vertexIndex 
     //          << " between plates " << getPlateA() << " and " << getPlateB() << std::endl;
     
-    Vec3 p = planet.vertices[vertexIndex];
+    Vec3 p = planet.positionOf(vertexIndex);
     Vec3 ridgePosition = q;
     
     //distance to ridge (dΓ)
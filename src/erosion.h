@@ -20,15 +20,19 @@ class Erosion {
 
     void erosion() {
         for (unsigned int vertexIdx = 0; vertexIdx < planet.vertices.size(); vertexIdx++) {
-            CrustType crustType = planet.crust_data[vertexIdx]->type;
-            if (crustType == CrustType::Continental) {
-                planet.crust_data[vertexIdx]->relief_elevation = continentalErosion(planet.crust_data[vertexIdx]->relief_elevation);
-            } else if (crustType == CrustType::Oceanic) {
-                planet.crust_data[vertexIdx]->relief_elevation = oceaincDampening(planet.crust_data[vertexIdx]->relief_elevation);
-            }
+            erodeCrust(*planet.crust_data[vertexIdx]);
         }
     };
 
+    // Un pas d'érosion sur une seule croûte (utilisé par les passes fusionnées de Simulation)
+    void erodeCrust(Crust& crust) {
+        if (crust.type == CrustType::Continental) {
+            crust.relief_elevation = continentalErosion(crust.relief_elevation);
+        } else if (crust.type == CrustType::Oceanic) {
+            crust.relief_elevation = oceaincDampening(crust.relief_elevation);
+        }
+    }
+
    private:
     float continentalErosion(float elevation) {
         return elevation - (elevation / max_elevation) * erosion_coefficient;
@@ -138,4 +138,71 @@ void Mesh::setupSphere(float radius, unsigned int numPoints) {
 
     // isSphere flag
     isSphere = true;
-}
\ No newline at end of file
+}
+
+// Inverse du treillis de setupSphere (Keinert et al., "Spherical Fibonacci Mapping") :
+// dans le plan (azimut, y) les points forment un réseau, localement engendré par les
+// décalages d'indice F_k et F_k+1 (nombres de Fibonacci, k choisi selon la densité à
+// cette latitude). On résout dans cette base puis on garde le plus proche des 4 coins,
+// mesuré avec la métrique locale de la sphère (azimut * r, y / r) : pas de trigonométrie
+// par coin.
+unsigned int fibonacciSphereIndex(const Vec3& direction, unsigned int numPoints) {
+    if (numPoints < 4) numPoints = 4;
+    const double PI = 3.14159265358979323846;
+    const double PHI = (1.0 + std::sqrt(5.0)) / 2.0;
+    const double alpha = 2.0 - PHI;            // pas d'azimut par indice, en tours
+    const double b = 2.0 / (numPoints - 1.0);  // pas de y par indice
+
+    // nombres de Fibonacci F_k, k < 64 (au-delà de 2^32 points)
+    static const struct Fibonacci {
+        double f[64];
+        Fibonacci() {
+            f[0] = 0.0;
+            f[1] = 1.0;
+            for (int k = 2; k < 64; ++k) f[k] = f[k - 1] + f[k - 2];
+        }
+    } fib;
+
+    double len = direction.length();
+    if (len <= 0.0) return 0;
+    double x = direction[0] / len, y = direction[1] / len, z = direction[2] / len;
+    y = std::min(1.0, std::max(-1.0, y));
+    double phi = std::atan2(z, x);
+    if (phi < 0.0) phi += 2.0 * PI;
+
+    // estimation directe par la latitude, utilisée près des pôles
+    long guess = std::lround((1.0 - y) / b);
+    unsigned int best = (unsigned int)std::min<long>(std::max<long>(guess, 0), numPoints - 1);
+
+    double r2 = 1.0 - y * y;
+    if (r2 < 1e-12) return best;
+    int k = (int)std::floor(std::log((numPoints - 1.0) * PI * std::sqrt(5.0) * r2) / std::log(PHI * PHI));
+    k = std::min(std::max(k, 2), 62);
+    double F0 = fib.f[k], F1 = fib.f[k + 1];
+
+    // base du réseau : décalage (azimut ramené dans ]-pi, pi], y) des indices F0 et F1
+    double a0 = 2.0 * PI * (F0 * alpha - std::round(F0 * alpha)), a1 = 2.0 * PI * (F1 * alpha - std::round(F1 * alpha));
+    double c0 = -b * F0, c1 = -b * F1;
+    double det = a0 * c1 - a1 * c0;
+    if (det == 0.0) return best;
+    double dy = y - 1.0;
+    double u = (c1 * phi - a1 * dy) / det;
+    double v = (a0 * dy - c0 * phi) / det;
+    double fu = std::floor(u), fv = std::floor(v);
+
+    double bestDist2 = std::numeric_limits<double>::max();
+    double r = std::sqrt(r2);
+    for (int s = 0; s < 4; ++s) {
+        double cu = fu + (s & 1), cv = fv + (s >> 1);
+        double i = F0 * cu + F1 * cv;
+        if (i < 0.0 || i > numPoints - 1.0) continue;
+        double du = cu - u, dv = cv - v;
+        double ex = (a0 * du + a1 * dv) * r, ey = (c0 * du + c1 * dv) / r;
+        double dist2 = ex * ex + ey * ey;
+        if (dist2 < bestDist2) {
+            bestDist2 = dist2;
+            best = (unsigned int)i;
+        }
+    }
+    return best;
+}
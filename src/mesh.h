@@ -47,5 +47,6 @@ class Mesh {
         void setupSphere(float radius, unsigned int numPoints);
 };
 
-
-
+// Indice du point de setupSphere(radius, numPoints) le plus proche de direction, en O(1).
+// Le treillis est généré en float : le résultat peut être un voisin du plus proche exact.
+unsigned int fibonacciSphereIndex(const Vec3& direction, unsigned int numPoints);
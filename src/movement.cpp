@@ -8,122 +8,70 @@
 #include <vector>
 
 #include "planet.h"
+#include "UnionFind.h"
 
 
 // public ========================================
 
 void Movement::movePlates(float deltaTime) {
-    for (Plate& plate : planet->plates) {
-        movePlate(plate, deltaTime);
-    }
+    beginStep(deltaTime);
     tectonicPhenomena = detectPhenomena();
     triggerEvents();
 }
 
 
-void Movement::triggerTerranesMigration() {
-    for (const auto& phenomenon : tectonicPhenomena) {
-        if (phenomenon->getType() == TectonicPhenomenon::Type::ContinentalCollision) {
-            ContinentalCollision* collisionPhenomenon = dynamic_cast<ContinentalCollision*>(phenomenon.get());
-            collisionPhenomenon->triggerTerranesMigration(*planet);
-        }
-    }
-}
+void Movement::beginStep(float deltaTime) {
+    // Les phénomènes du pas précédent vivent dans l'arène : on rend le
+    // stockage du vecteur avant de la remettre à zéro.
+    SegmentList().swap(boundarySegments);
+    PhenomenonList().swap(tectonicPhenomena);
+    StepArena::resetStep();
 
-
-std::vector<std::unique_ptr<TectonicPhenomenon>> Movement::detectPhenomena() {
-    std::vector<std::unique_ptr<TectonicPhenomenon>> phenomena;
-
-    if (planet->plates.empty() || planet->vertices.empty()) {
-        return phenomena;
+    for (unsigned int p = 0; p < planet->plates.size(); ++p) {
+        movePlate(p, deltaTime);
     }
+}
 
 
-    std::vector<Vec3> plateCentroids = computePlateCentroids();
-    // le cache sert a eviter de detecter plusieurs fois la meme interaction
-    PhenomenaDetectionCache cache;
-    
-    for (unsigned int vertexIdx = 0; vertexIdx < planet->vertices.size(); ++vertexIdx) {
-        int plateA = planet->verticesToPlates[vertexIdx];
-        if (plateA < 0) continue;
-        
-        for (unsigned int neighborIdx : planet->neighbors[vertexIdx]) {
-            int plateB = planet->verticesToPlates[neighborIdx];
-            if (plateB < 0 || plateB == plateA) continue;
-            
-
-            if (cache.alreadyProcessed(plateA, plateB, vertexIdx)) {
-                continue;
-            }
-            
-            // Analyser l'interaction entre les deux plaques
-            PlateInteraction interaction = analyzePlateInteraction(
-                plateA, plateB, vertexIdx, neighborIdx, plateCentroids
-            );
-            
-            // Créer le phénomène approprié selon le type d'interaction
-            auto phenomenon = createPhenomenon(interaction, cache);
-            if (phenomenon) {
-                phenomena.push_back(std::move(phenomenon));
-            }
+void Movement::triggerTerranesMigration() {
+    // Changements de plaque : les positions doivent être dans le repère monde
+    planet->materializePositions();
+    for (const TectonicPhenomenon& phenomenon : tectonicPhenomena) {
+        if (phenomenon.type == TectonicPhenomenon::Type::ContinentalCollision) {
+            ::triggerTerranesMigration(phenomenon, *planet);
         }
     }
-    
-    return phenomena;
 }
 
-// private ========================================
 
-std::vector<Vec3> Movement::computePlateCentroids() const {
-    size_t numPlates = planet->plates.size();
-    std::vector<Vec3> centroids(numPlates, Vec3(0.0f, 0.0f, 0.0f));
-    std::vector<unsigned int> counts(numPlates, 0);
+void Movement::detectAtVertex(unsigned int vertexIdx, const PlateStateTable& plateStates,
+                              PhenomenaDetectionCache& cache, PhenomenonList& phenomena) {
+    int plateA = planet->verticesToPlates[vertexIdx];
+    if (plateA < 0) return;
     
-    for (size_t p = 0; p < numPlates; ++p) {
-        for (unsigned int vidx : planet->plates[p].vertices_indices) {
-            if (vidx < planet->vertices.size()) {
-                centroids[p] += planet->vertices[vidx];
-                counts[p]++;
-            }
-        }
+    for (unsigned int neighborIdx : planet->neighbors[vertexIdx]) {
+        int plateB = planet->verticesToPlates[neighborIdx];
+        if (plateB < 0 || plateB == plateA) continue;
         
-        if (counts[p] > 0) {
-            centroids[p] /= static_cast<float>(counts[p]);
-            centroids[p].normalize();
-            centroids[p] *= planet->radius;
-        }
-    }
-    
-    return centroids;
-}
 
-//dans le cas ou collision entre 2 oceans le plus vieux plonge
-float Movement::computePlateAverageOceanicAge(unsigned int plateIdx) const {
-    if (plateIdx >= planet->plates.size()) return 0.0f;
-    
-    const Plate& plate = planet->plates[plateIdx];
-    float sumAge = 0.0f;
-    unsigned int count = 0;
-    
-    const unsigned int maxSamples = 50;
-    
-    for (unsigned int vidx : plate.vertices_indices) {
-        if (vidx >= planet->crust_data.size() || !planet->crust_data[vidx]) {
+        if (cache.alreadyProcessed(plateA, plateB, vertexIdx)) {
             continue;
         }
         
-        auto* oceanicCrust = dynamic_cast<OceanicCrust*>(planet->crust_data[vidx].get());
-        if (oceanicCrust) {
-            sumAge += oceanicCrust->age;
-            count++;
-            
-            if (count >= maxSamples) break;
+        // Analyser l'interaction entre les deux plaques
+        PlateInteraction interaction = analyzePlateInteraction(
+            plateA, plateB, vertexIdx, neighborIdx, plateStates
+        );
+        
+        // Créer le phénomène approprié selon le type d'interaction
+        TectonicPhenomenon phenomenon;
+        if (createPhenomenon(interaction, phenomenon)) {
+            phenomena.push_back(phenomenon);
         }
     }
-    
-    return (count > 0) ? (sumAge / static_cast<float>(count)) : 0.0f;
 }
 
+// private ========================================
 
 bool Movement::isOceanicCrust(unsigned int vertexIdx) const {
     if (vertexIdx >= planet->crust_data.size() || !planet->crust_data[vertexIdx]) {
@@ -133,15 +81,7 @@ bool Movement::isOceanicCrust(unsigned int vertexIdx) const {
 }
 
 
-Vec3 Movement::computePlateVelocity(const Plate& plate, const Vec3& position) const {
-    Vec3 omega = plate.rotation_axis;
-    omega.normalize();
-    omega *= plate.plate_velocity;
-    return Vec3::cross(omega, position);
-}
-
-
-PlateInteraction Movement::analyzePlateInteraction(int plateA, int plateB, unsigned int vertexIdx, unsigned int neighborIdx, const std::vector<Vec3>& plateCentroids) const 
+PlateInteraction Movement::analyzePlateInteraction(int plateA, int plateB, unsigned int vertexIdx, unsigned int neighborIdx, const PlateStateTable& plateStates) const 
 {
     PlateInteraction interaction;
     interaction.plateA = static_cast<unsigned int>(plateA);
@@ -153,12 +93,14 @@ PlateInteraction Movement::analyzePlateInteraction(int plateA, int plateB, unsig
     interaction.isOceanicA = isOceanicCrust(vertexIdx);
     interaction.isOceanicB = isOceanicCrust(neighborIdx);
     
+    const PlateState& stateA = plateStates[plateA];
+    const PlateState& stateB = plateStates[plateB];
 
-    interaction.ageA = interaction.isOceanicA ? computePlateAverageOceanicAge(plateA) : 0.0f;
-    interaction.ageB = interaction.isOceanicB ? computePlateAverageOceanicAge(plateB) : 0.0f;
+    interaction.ageA = interaction.isOceanicA ? stateA.meanOceanicAge : 0.0f;
+    interaction.ageB = interaction.isOceanicB ? stateB.meanOceanicAge : 0.0f;
     
     // Direction de A vers B
-    interaction.directionAtoB = plateCentroids[plateB] - plateCentroids[plateA];
+    interaction.directionAtoB = stateB.centroid - stateA.centroid;
     float length = interaction.directionAtoB.length();
     if (length > 1e-8f) {
         interaction.directionAtoB /= length;
@@ -166,12 +108,9 @@ PlateInteraction Movement::analyzePlateInteraction(int plateA, int plateB, unsig
         interaction.directionAtoB = Vec3(0.0f, 0.0f, 0.0f);
     }
     
-    // Calculer les vitesses relatives
-    Vec3 position = planet->vertices[vertexIdx];
-    Vec3 velocityA = computePlateVelocity(planet->plates[plateA], position);
-    Vec3 velocityB = computePlateVelocity(planet->plates[plateB], position);
-    
-    Vec3 relativeVelocity = velocityA - velocityB;
+    // Calculer les vitesses relatives : v_a - v_b = (omega_a - omega_b) x p
+    Vec3 position = planet->positionOf(vertexIdx);
+    Vec3 relativeVelocity = Vec3::cross(plateStates.relativeRotation(plateA, plateB), position);
     interaction.convergence = Vec3::dot(relativeVelocity, interaction.directionAtoB);
     
     return interaction;
@@ -181,13 +120,12 @@ PlateInteraction Movement::analyzePlateInteraction(int plateA, int plateB, unsig
 
 
 
-std::unique_ptr<TectonicPhenomenon> Movement::createConvergencePhenomenon(
-    const PlateInteraction& interaction,
-    PhenomenaDetectionCache& cache) 
+TectonicPhenomenon Movement::createConvergencePhenomenon(
+    const PlateInteraction& interaction) const
 {
     // ===== Cas 1: Continental-Continental = Collision =====
     if (!interaction.isOceanicA && !interaction.isOceanicB) {
-        return std::make_unique<ContinentalCollision>(
+        return TectonicPhenomenon::continentalCollision(
             interaction.plateA,
             interaction.plateB,
             interaction.vertexIdx,
@@ -205,14 +143,14 @@ std::unique_ptr<TectonicPhenomenon> Movement::createConvergencePhenomenon(
             ? interaction.plateB 
             : interaction.plateA;
         
-        return std::make_unique<Subduction>(
+        return TectonicPhenomenon::subduction(
             interaction.plateA,
             interaction.plateB,
             interaction.vertexIdx,
             plateUnder,
             plateOver,
             interaction.convergence,
-            Subduction::SubductionType::Oceanic_Oceanic,
+            TectonicPhenomenon::SubductionType::Oceanic_Oceanic,
             "oceanic-oceanic: older plate subducts"
         );
     }
@@ -221,24 +159,24 @@ std::unique_ptr<TectonicPhenomenon> Movement::createConvergencePhenomenon(
     unsigned int plateUnder = interaction.isOceanicA ? interaction.plateA : interaction.plateB;
     unsigned int plateOver = interaction.isOceanicA ? interaction.plateB : interaction.plateA;
     
-    return std::make_unique<Subduction>(
+    return TectonicPhenomenon::subduction(
         interaction.plateA,
         interaction.plateB,
         interaction.vertexIdx,
         plateUnder,
         plateOver,
         interaction.convergence,
-        Subduction::SubductionType::Oceanic_Continental,
+        TectonicPhenomenon::SubductionType::Oceanic_Continental,
         "oceanic under continental"
     );
 }
 
 
-std::unique_ptr<TectonicPhenomenon> Movement::createDivergencePhenomenon(
-    const PlateInteraction& interaction) 
+TectonicPhenomenon Movement::createDivergencePhenomenon(
+    const PlateInteraction& interaction) const
 {
     float divergence = std::abs(interaction.convergence);
-    std::string reason;
+    const char* reason;
     
     if (interaction.isOceanicA && interaction.isOceanicB) {
         reason = "oceanic-oceanic rifting: mid-ocean ridge";
@@ -248,7 +186,7 @@ std::unique_ptr<TectonicPhenomenon> Movement::createDivergencePhenomenon(
         reason = "mixed rifting zone";
     }
     
-    return std::make_unique<crustGeneration>(
+    return TectonicPhenomenon::crustGeneration(
         interaction.plateA,
         interaction.plateB,
         interaction.vertexIdx,
@@ -259,49 +197,174 @@ std::unique_ptr<TectonicPhenomenon> Movement::createDivergencePhenomenon(
 
 
 
-std::unique_ptr<TectonicPhenomenon> Movement::createPhenomenon(
+bool Movement::createPhenomenon(
     const PlateInteraction& interaction,
-    PhenomenaDetectionCache& cache) 
+    TectonicPhenomenon& phenomenon) const
 {
     // ===== CONVERGENCE (plaques se rapprochent) =====
     if (interaction.convergence > convergenceThreshold) {
-        return createConvergencePhenomenon(interaction, cache);
+        phenomenon = createConvergencePhenomenon(interaction);
+        return true;
     }
     
     // ===== DIVERGENCE (plaques s'éloignent) =====
     else if (interaction.convergence < -convergenceThreshold) {
-        return createDivergencePhenomenon(interaction);
+        phenomenon = createDivergencePhenomenon(interaction);
+        return true;
     }
     
     // Pas de phénomène significatif
-    return nullptr;
+    return false;
 }
 
 
-void Movement::movePlate(Plate& plate, float deltaTime) {
+Quat Movement::plateRotation(const Plate& plate, float deltaTime) const {
+    float angle = plate.plate_velocity * deltaTime * movementAttenuation;
+    return Quat::fromAxisAndAngle(plate.rotation_axis, angle);
+}
+
+// Mouvement rigide : on compose seulement la rotation de la plaque (O(1)),
+// les positions sont recalculées à la demande (Planet::positionOf / materializePositions).
+void Movement::movePlate(unsigned int plateIdx, float deltaTime) {
+    const Plate& plate = planet->plates[plateIdx];
     if (plate.plate_velocity == 0.0) {
         return;
     }
-    for (int v = 0; v < plate.vertices_indices.size(); v++) {
-        unsigned int vertexIndex = plate.vertices_indices[v];
-        Vec3& vertexPos = planet->vertices[vertexIndex];
-
-        Vec3 toVertex = vertexPos;
-        Vec3 axis = plate.rotation_axis;
-        axis.normalize();
+    planet->rotatePlate(plateIdx, plateRotation(plate, deltaTime));
+}
 
-        float angle = plate.plate_velocity * deltaTime * movementAttenuation;
+void Movement::triggerEvents() {
+    aggregatePhenomena();
 
-        Vec3 rotatedPos = toVertex * cos(angle) +
-                          Vec3::cross(axis, toVertex) * sin(angle) +
-                          axis * Vec3::dot(axis, toVertex) * (1 - cos(angle));
+    // Une zone par (segment, sommet frontière)
+    ArenaVector<std::pair<unsigned int, unsigned int>> zones;
+    for (unsigned int s = 0; s < boundarySegments.size(); ++s) {
+        for (unsigned int frontierVertex : boundarySegments[s].frontier) zones.emplace_back(s, frontierVertex);
+    }
+    if (zones.empty()) return;
+
+    size_t nChunks = (zones.size() + eventChunkSize - 1) / eventChunkSize;
+    ArenaVector<ArenaPtr<UpliftBuffer>> buffers(nChunks);
+    const Planet& source = *planet;
+    source.boundaryDistances();  // lu par les événements, reconstruit hors de la section parallèle
+
+    parallelChunks(zones.size(), eventChunkSize, [&](size_t chunk, size_t begin, size_t end) {
+        StepArena& arena = StepArena::threadArena();
+        buffers[chunk] = makeArenaPtr<UpliftBuffer>(arena, ArenaAllocator<UpliftDelta>(arena));
+        for (size_t i = begin; i < end; ++i) {
+            evaluateEvent(boundarySegments[zones[i].first], zones[i].second, source, *buffers[chunk]);
+        }
+    });
+
+    // Réduction dans l'ordre des blocs
+    for (const auto& buffer : buffers) {
+        for (const UpliftDelta& uplift : *buffer) {
+            Crust& crust = *planet->crust_data[uplift.vertex];
+            if (uplift.underSubduction) crust.is_under_subduction = true;
+            else crust.relief_elevation += uplift.delta;
+        }
+    }
+}
 
-        vertexPos = rotatedPos;
+bool Movement::sameSegment(const TectonicPhenomenon& a, const TectonicPhenomenon& b) {
+    if (a.type != b.type) return false;
+    if (a.type == TectonicPhenomenon::Type::Subduction) {
+        return a.subduction_type == b.subduction_type &&
+               a.plate_under == b.plate_under && a.plate_over == b.plate_over;
     }
+    // vue depuis l'un ou l'autre côté de la frontière : paire non ordonnée
+    return std::min(a.plate_a, a.plate_b) == std::min(b.plate_a, b.plate_b) &&
+           std::max(a.plate_a, a.plate_b) == std::max(b.plate_a, b.plate_b);
 }
 
-void Movement::triggerEvents() {
-    for (const auto& phenomenon : tectonicPhenomena) {
-        phenomenon->triggerEvent(*planet);
+void Movement::aggregatePhenomena() {
+    SegmentList().swap(boundarySegments);
+    const PhenomenonList& phenomena = tectonicPhenomena;
+    unsigned int n = (unsigned int)phenomena.size();
+    if (n == 0) return;
+
+    const unsigned int none = std::numeric_limits<unsigned int>::max();
+    size_t N = planet->vertices.size();
+    if (vertexPhenomenon.size() != N) {
+        vertexPhenomenon.assign(N, none);
+        frontierSegment.assign(N, none);
+        frontierDist2.assign(N, 0.0f);
+    }
+
+    // Les phénomènes d'un même sommet sont contigus (détection par sommet croissant)
+    for (unsigned int i = 0; i < n; ++i) {
+        unsigned int v = phenomena[i].vertex_index;
+        if (vertexPhenomenon[v] == none) vertexPhenomenon[v] = i;
+    }
+
+    // Composantes connexes le long des arêtes du maillage
+    UnionFind components(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        for (unsigned int neighbor : planet->neighbors[phenomena[i].vertex_index]) {
+            for (unsigned int j = vertexPhenomenon[neighbor]; j < n && phenomena[j].vertex_index == neighbor; ++j) {
+                if (sameSegment(phenomena[i], phenomena[j])) components.unite(i, j);
+            }
+        }
+    }
+
+    // Carré de la corde de v à son plus proche voisin sur la plaque opposée
+    auto frontDistance2 = [&](unsigned int v, unsigned int otherPlate) {
+        Vec3 x = planet->positionOf(v);
+        float best = std::numeric_limits<float>::max();
+        for (unsigned int neighbor : planet->neighbors[v]) {
+            if (planet->verticesToPlates[neighbor] != otherPlate) continue;
+            best = std::min(best, (planet->positionOf(neighbor) - x).squareLength());
+        }
+        return best;
+    };
+
+    // Un segment par composante, dans l'ordre du premier phénomène. Chaque sommet frontière
+    // est rattaché au segment dont le front est le plus proche (à égalité, le plus petit
+    // indice) : sa zone n'est soulevée qu'une fois.
+    ArenaVector<unsigned int> segmentOf(n, none);
+    for (unsigned int i = 0; i < n; ++i) {
+        const TectonicPhenomenon& phenomenon = phenomena[i];
+        unsigned int root = components.find(i);
+        if (segmentOf[root] == none) {
+            segmentOf[root] = (unsigned int)boundarySegments.size();
+            boundarySegments.emplace_back();
+            boundarySegments.back().summary = phenomenon;
+            boundarySegments.back().summary.magnitude = 0.0f;
+        }
+        BoundarySegment& segment = boundarySegments[segmentOf[root]];
+        segment.summary.magnitude += phenomenon.magnitude;
+        segment.interactionCount++;
+
+        unsigned int v = phenomenon.vertex_index;
+        // seule la plaque chevauchante est soulevée par une subduction,
+        // la génération de croûte ne soulève rien pendant le pas
+        bool influences = phenomenon.type == TectonicPhenomenon::Type::ContinentalCollision ||
+                          (phenomenon.type == TectonicPhenomenon::Type::Subduction &&
+                           planet->verticesToPlates[v] == phenomenon.plate_over);
+        if (influences) {
+            unsigned int plate = planet->verticesToPlates[v];
+            float dist2 = frontDistance2(v, phenomenon.plate_a == plate ? phenomenon.plate_b : phenomenon.plate_a);
+            // segments créés par indice croissant : à égalité le premier reste
+            if (frontierSegment[v] == none || dist2 < frontierDist2[v]) {
+                frontierSegment[v] = segmentOf[root];
+                frontierDist2[v] = dist2;
+            }
+        }
+    }
+
+    // Zones dans l'ordre des phénomènes
+    for (unsigned int i = 0; i < n; ++i) {
+        unsigned int v = phenomena[i].vertex_index;
+        if (frontierSegment[v] == none) continue;
+        boundarySegments[frontierSegment[v]].frontier.push_back(v);
+        frontierSegment[v] = none;
+    }
+
+    for (BoundarySegment& segment : boundarySegments) {
+        segment.summary.magnitude /= (float)segment.interactionCount;
+    }
+
+    for (const TectonicPhenomenon& phenomenon : phenomena) {
+        vertexPhenomenon[phenomenon.vertex_index] = none;
     }
 }
\ No newline at end of file
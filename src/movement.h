@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <unordered_set>
 
 #include "Vec3.h"
+#include "Arena.h"
+#include "Parallel.h"
 #include "planet.h"
 #include "tectonicPhenomenon.h"
 
@@ -28,29 +33,28 @@ struct PlateInteraction {
     Vec3 directionAtoB;     // Direction normalisée de A vers B
 };
 
+// Une interaction est identifiée par (plaque min, plaque max, sommet) : deux sommets
+// différents ne partagent jamais de clé, il suffit donc de retenir les paires de plaques
+// déjà vues au sommet courant. Un cache par bloc de sommets, sans état partagé entre threads.
 class PhenomenaDetectionCache {
 private:
-    struct EdgeKey {
-        unsigned int a, b, v;
-        bool operator==(const EdgeKey& other) const {
-            return a == other.a && b == other.b && v == other.v;
-        }
-    };
-    
-    struct EdgeKeyHash {
-        size_t operator()(const EdgeKey& k) const noexcept {
-            return (k.a * 73856093u) ^ (k.b * 19349663u) ^ (k.v * 83492791u);
-        }
-    };
-    
-    std::unordered_set<EdgeKey, EdgeKeyHash> processedEdges;
+    unsigned int currentVertex = std::numeric_limits<unsigned int>::max();
+    std::vector<uint64_t> processedPairs;
     
 public:
     bool alreadyProcessed(int plateA, int plateB, unsigned int vertex) {
+        if (vertex != currentVertex) {
+            currentVertex = vertex;
+            processedPairs.clear();
+        }
         unsigned int minPlate = std::min((unsigned int)plateA, (unsigned int)plateB);
         unsigned int maxPlate = std::max((unsigned int)plateA, (unsigned int)plateB);
-        EdgeKey key{minPlate, maxPlate, vertex};
-        return !processedEdges.insert(key).second;
+        uint64_t key = ((uint64_t)minPlate << 32) | maxPlate;
+        if (std::find(processedPairs.begin(), processedPairs.end(), key) != processedPairs.end()) {
+            return true;
+        }
+        processedPairs.push_back(key);
+        return false;
     }
     
 };
@@ -64,37 +68,108 @@ class Movement {
     float movementAttenuation = 0.005f;
     float convergenceThreshold = 0.00001f;
 
-    std::vector<std::unique_ptr<TectonicPhenomenon>> tectonicPhenomena;
+    PhenomenonList tectonicPhenomena;
+    SegmentList boundarySegments;     // tectonicPhenomena regroupés (cf. aggregatePhenomena)
     
     Movement(Planet& p) : planet(&p) {}
 
     void movePlates(float deltaTime);
     void triggerTerranesMigration();
-    std::vector<std::unique_ptr<TectonicPhenomenon>> detectPhenomena();
+    PhenomenonList detectPhenomena() {
+        return detectPhenomena([](size_t, size_t) {});
+    }
 
-   private:
+    // Détection parallèle par blocs fixes de sommets, fusionnés dans l'ordre des blocs :
+    // même résultat que la boucle séquentielle, quel que soit le nombre de threads.
+    // beforeChunk(begin, end) est appelé sur chaque bloc juste avant sa détection.
+    template <class BeforeChunk>
+    PhenomenonList detectPhenomena(BeforeChunk beforeChunk);
 
-    void movePlate(Plate& plate, float deltaTime);
+    // Étapes de movePlates, exposées pour les passes fusionnées de Simulation
+    void beginStep(float deltaTime);
+    void detectAtVertex(unsigned int vertexIdx, const PlateStateTable& plateStates,
+                        PhenomenaDetectionCache& cache, PhenomenonList& phenomena);
+    // Regroupe tectonicPhenomena en segments de frontière (composantes connexes d'interactions
+    // de même type entre les mêmes plaques), dans l'ordre de leur premier phénomène
+    void aggregatePhenomena();
+    // Soulèvements évalués en parallèle par blocs fixes de zones dans des tampons de deltas,
+    // puis réduits dans l'ordre des blocs : indépendant du nombre de threads.
     void triggerEvents();
+
+    static const size_t detectionChunkSize = 4096;
+    static const size_t eventChunkSize = 64;   // zones (sommets frontière) par bloc
+
+   private:
+    // Tableaux par sommet réutilisés d'un pas à l'autre ; seules les entrées
+    // des sommets des phénomènes sont écrites puis remises à zéro.
+    std::vector<unsigned int> vertexPhenomenon;
+    // Segment retenu pour un sommet frontière et carré de la distance à son front
+    std::vector<unsigned int> frontierSegment;
+    std::vector<float> frontierDist2;
+
+    static bool sameSegment(const TectonicPhenomenon& a, const TectonicPhenomenon& b);
+
+    void movePlate(unsigned int plateIdx, float deltaTime);
+    Quat plateRotation(const Plate& plate, float deltaTime) const;
     
-    std::vector<Vec3> computePlateCentroids() const;
-    float computePlateAverageOceanicAge(unsigned int plateIdx) const;
     bool isOceanicCrust(unsigned int vertexIdx) const;
-    Vec3 computePlateVelocity(const Plate& plate, const Vec3& position) const;
     
     PlateInteraction analyzePlateInteraction(
         int plateA, int plateB, 
         unsigned int vertexIdx, unsigned int neighborIdx,
-        const std::vector<Vec3>& plateCentroids) const;
+        const PlateStateTable& plateStates) const;
     
-    std::unique_ptr<TectonicPhenomenon> createPhenomenon(
+    // Retourne false si l'interaction ne produit pas de phénomène
+    bool createPhenomenon(
         const PlateInteraction& interaction,
-        PhenomenaDetectionCache& cache);
+        TectonicPhenomenon& phenomenon) const;
     
-    std::unique_ptr<TectonicPhenomenon> createConvergencePhenomenon(
-        const PlateInteraction& interaction,
-        PhenomenaDetectionCache& cache);
+    TectonicPhenomenon createConvergencePhenomenon(
+        const PlateInteraction& interaction) const;
     
-    std::unique_ptr<TectonicPhenomenon> createDivergencePhenomenon(
-        const PlateInteraction& interaction);
-};
\ No newline at end of file
+    TectonicPhenomenon createDivergencePhenomenon(
+        const PlateInteraction& interaction) const;
+};
+
+
+template <class BeforeChunk>
+PhenomenonList Movement::detectPhenomena(BeforeChunk beforeChunk) {
+    PhenomenonList phenomena;
+
+    if (planet->plates.empty() || planet->vertices.empty()) {
+        return phenomena;
+    }
+
+    // Propriétés des plaques calculées une fois pour le pas (lues aussi par les événements)
+    planet->plateStates.build(*planet);
+    const PlateStateTable& plateStates = planet->plateStates;
+    // Seuls les sommets frontière peuvent produire un phénomène (liste triée avant la section parallèle)
+    const PlateBoundaryIndex& boundary = planet->boundary();
+    const std::vector<unsigned int>& boundaryVertices = boundary.vertices();
+
+    // Un tampon par bloc, alloué dans l'arène du thread qui le traite
+    size_t N = planet->vertices.size();
+    size_t nChunks = (N + detectionChunkSize - 1) / detectionChunkSize;
+    ArenaVector<ArenaPtr<PhenomenonList>> buffers(nChunks);
+
+    parallelChunks(N, detectionChunkSize, [&](size_t chunk, size_t begin, size_t end) {
+        StepArena& arena = StepArena::threadArena();
+        buffers[chunk] = makeArenaPtr<PhenomenonList>(arena, ArenaAllocator<TectonicPhenomenon>(arena));
+        beforeChunk(begin, end);
+
+        PhenomenaDetectionCache cache;
+        std::pair<size_t, size_t> r = boundary.range((unsigned int)begin, (unsigned int)end);
+        for (size_t i = r.first; i < r.second; ++i) {
+            detectAtVertex(boundaryVertices[i], plateStates, cache, *buffers[chunk]);
+        }
+    });
+
+    // Fusion déterministe dans l'ordre des blocs
+    size_t total = 0;
+    for (const auto& buffer : buffers) total += buffer->size();
+    phenomena.reserve(total);
+    for (const auto& buffer : buffers) {
+        phenomena.insert(phenomena.end(), buffer->begin(), buffer->end());
+    }
+    return phenomena;
+}
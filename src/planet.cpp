@@ -6,6 +6,8 @@
 #include <random>
 #include <algorithm>
 #include <unordered_set>
+#include <queue>
+#include <map>
 
 
 #include "planet.h"
@@ -13,11 +15,14 @@
 #include "crust.h"
 #include "SphericalGrid.h"
 #include "util.h"
+#include "Parallel.h"
 
 
 
 void Planet::detectVerticesNeighbors() {
     neighbors.resize(vertices.size());
+    boundaryIndex.invalidate();
+    boundaryDistanceField.invalidate();
 
     // Construire la liste des voisins (adjacence)
     for (const Triangle& t : triangles) {
@@ -161,6 +166,8 @@ void Planet::generatePlates(unsigned int n_plates) {
     detectVerticesNeighbors();
     findFrontierVertices();
     fillClosestFrontierVertices();
+    centroidTracker.invalidate();
+    plateIndexSet.invalidate();
 
     std::uniform_real_distribution<float> dist01(0.1f, 0.9f);
     const float TWO_PI = 6.28318530717958647692f;
@@ -178,48 +185,262 @@ void Planet::generatePlates(unsigned int n_plates) {
 }
 
 void Planet::findFrontierVertices() {
-    for (unsigned int i = 0; i < vertices.size(); i++) {
-        const std::vector<unsigned int>& vertexNeighbors = neighbors[i];
-        unsigned int currentPlateIdx = verticesToPlates[i];
-
-        for (unsigned int n = 0; n < vertexNeighbors.size(); n++) {
-            unsigned int neighborIdx = vertexNeighbors[n];
-            unsigned int neighborPlateIdx = verticesToPlates[neighborIdx];
-            if (neighborPlateIdx != currentPlateIdx) {
-                plates[currentPlateIdx].closestFrontierVertices[i] = std::vector<unsigned int>();
-                break;
+    for (unsigned int i : boundary().vertices()) {
+        plates[verticesToPlates[i]].closestFrontierVertices[i] = std::vector<unsigned int>();
+    }
+}
+
+// Dijkstra multi-sources restreint aux sommets de la plaque, amorcé aux clés de
+// closestFrontierVertices. Chaque sommet reçoit la frontière qui l'atteint en premier.
+static void propagateClosestFrontier(Planet& planet, unsigned int plateIdx, bool geodesic) {
+    const unsigned int noFrontier = std::numeric_limits<unsigned int>::max();
+    Plate& plate = planet.plates[plateIdx];
+
+    // (distance, (sommet, frontière)) : départage déterministe à distance égale
+    typedef std::pair<float, std::pair<unsigned int, unsigned int>> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (const auto& pair : plate.closestFrontierVertices) {
+        heap.push(Entry(0.0f, std::make_pair(pair.first, pair.first)));
+    }
+
+    while (!heap.empty()) {
+        Entry entry = heap.top();
+        heap.pop();
+        float d = entry.first;
+        unsigned int v = entry.second.first;
+        unsigned int frontier = entry.second.second;
+
+        // une clé périmée peut ne plus appartenir à la plaque : elle amorce sans être étiquetée
+        if (planet.verticesToPlates[v] == plateIdx) {
+            if (planet.closestFrontier[v] != noFrontier) continue;
+            planet.closestFrontier[v] = frontier;
+            planet.frontierDistance[v] = d;
+        }
+
+        for (unsigned int n : planet.neighbors[v]) {
+            if (planet.verticesToPlates[n] != plateIdx || planet.closestFrontier[n] != noFrontier) continue;
+            float nd = geodesic ? d + (planet.vertices[n] - planet.vertices[v]).length()
+                                : (planet.vertices[n] - planet.vertices[frontier]).length();
+            if (nd < planet.frontierDistance[n]) {
+                planet.frontierDistance[n] = nd;
+                heap.push(Entry(nd, std::make_pair(n, frontier)));
+            }
+        }
+    }
+
+    // Composante de la plaque sans frontière atteignable : recherche directe
+    for (unsigned int v : plate.vertices_indices) {
+        if (planet.closestFrontier[v] != noFrontier) continue;
+        float minDist = std::numeric_limits<float>::max();
+        for (const auto& pair : plate.closestFrontierVertices) {
+            float dist = (planet.vertices[v] - planet.vertices[pair.first]).length();
+            if (dist < minDist) {
+                minDist = dist;
+                planet.closestFrontier[v] = pair.first;
             }
         }
+        planet.frontierDistance[v] = minDist;
+    }
+
+    std::map<unsigned int, std::vector<unsigned int>> newMapping;
+    for (unsigned int v : plate.vertices_indices) {
+        newMapping[planet.closestFrontier[v]].push_back(v);
     }
+    plate.closestFrontierVertices = newMapping;
 }
 
-void Planet::fillClosestFrontierVertices() { //TODO Optimiser cette fonction
+void Planet::fillClosestFrontierVertices(bool geodesic) {
+    if (neighbors.size() != vertices.size()) detectVerticesNeighbors();
+
+    size_t N = vertices.size();
+    closestFrontier.assign(N, std::numeric_limits<unsigned int>::max());
+    frontierDistance.assign(N, std::numeric_limits<float>::max());
+    frontierGeodesic = geodesic;
+    frontierChangedFrom.assign(N, noPlate);
+    frontierChanges.clear();
+
+    // Les plaques sont disjointes : chacune n'écrit que ses propres sommets
+    parallelFor(0, plates.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            if (plates[p].closestFrontierVertices.empty()) continue;
+            propagateClosestFrontier(*this, (unsigned int)p, geodesic);
+        }
+    });
+}
 
-    for (Plate& plate : plates) {
-        std::vector<unsigned int> frontierVertices;
-        for (const auto& pair : plate.closestFrontierVertices) {
-            frontierVertices.push_back(pair.first);
+// Réparation locale : les distances ne font que diminuer depuis les graines, la propagation
+// s'arrête d'elle-même là où l'étiquette ne change plus. Le premier changement de chaque
+// sommet est noté dans changed avec son ancienne étiquette.
+typedef std::pair<float, std::pair<unsigned int, unsigned int>> FrontierEntry;
+
+struct FrontierRepair {
+    unsigned int plate;
+    std::vector<FrontierEntry> seeds;
+    std::vector<std::pair<unsigned int, unsigned int>> changed;  // (sommet, ancienne étiquette)
+};
+
+static void repairClosestFrontier(Planet& planet, FrontierRepair& repair, std::vector<uint8_t>& mark) {
+    std::priority_queue<FrontierEntry, std::vector<FrontierEntry>, std::greater<FrontierEntry>> heap(
+        std::greater<FrontierEntry>(), std::move(repair.seeds));
+
+    while (!heap.empty()) {
+        FrontierEntry entry = heap.top();
+        heap.pop();
+        float d = entry.first;
+        unsigned int v = entry.second.first;
+        unsigned int frontier = entry.second.second;
+        if (d != planet.frontierDistance[v] || frontier != planet.closestFrontier[v]) continue;
+
+        for (unsigned int n : planet.neighbors[v]) {
+            if (planet.verticesToPlates[n] != repair.plate) continue;
+            float nd = planet.frontierGeodesic ? d + (planet.vertices[n] - planet.vertices[v]).length()
+                                               : (planet.vertices[n] - planet.vertices[frontier]).length();
+            if (!(nd < planet.frontierDistance[n])) continue;
+            if (!mark[n]) {
+                mark[n] = 1;
+                repair.changed.push_back(std::make_pair(n, planet.closestFrontier[n]));
+            }
+            planet.frontierDistance[n] = nd;
+            planet.closestFrontier[n] = frontier;
+            heap.push(FrontierEntry(nd, std::make_pair(n, frontier)));
         }
+    }
+}
+
+static void removeFromZone(Plate& plate, unsigned int frontier, unsigned int v) {
+    auto zone = plate.closestFrontierVertices.find(frontier);
+    if (zone == plate.closestFrontierVertices.end()) return;
+    std::vector<unsigned int>& members = zone->second;
+    auto it = std::find(members.begin(), members.end(), v);
+    if (it == members.end()) return;
+    *it = members.back();
+    members.pop_back();
+}
 
-        if (frontierVertices.empty()) continue;
-        std::map<unsigned int, std::vector<unsigned int>> newMapping;
+void Planet::updateFrontierInfluence() {
+    if (frontierChanges.empty()) return;
+    size_t N = vertices.size();
+    if (closestFrontier.size() != N || frontierChangedFrom.size() != N) {
+        frontierChanges.clear();
+        return;
+    }
 
-        for (unsigned int vertexIdx : plate.vertices_indices) {
-            float minDist = std::numeric_limits<float>::max();
-            unsigned int closestFrontier = frontierVertices[0];
+    const unsigned int noFrontier = std::numeric_limits<unsigned int>::max();
+    const PlateBoundaryIndex& index = boundary();
+    if (frontierMark.size() != N) frontierMark.assign(N, 0);
+    std::vector<uint8_t>& mark = frontierMark;
+
+    // 1. Le statut de frontière ne peut changer que pour les sommets changés et leurs voisins
+    std::vector<unsigned int> candidates;
+    for (unsigned int v : frontierChanges) {
+        if (!mark[v]) { mark[v] = 1; candidates.push_back(v); }
+        for (unsigned int n : neighbors[v]) {
+            if (!mark[n]) { mark[n] = 1; candidates.push_back(n); }
+        }
+    }
+
+    std::vector<unsigned int> staleFrontiers, newFrontiers;
+    for (unsigned int v : candidates) {
+        mark[v] = 0;
+        bool moved = frontierChangedFrom[v] != noPlate;
+        bool wasFrontier = closestFrontier[v] == v;
+        bool isFrontier = index.isBoundary(v);
+        if (wasFrontier && (moved || !isFrontier)) staleFrontiers.push_back(v);
+        if (isFrontier && (moved || !wasFrontier)) newFrontiers.push_back(v);
+    }
+
+    // 2. Invalidation : zones des frontières disparues, sommets changés de plaque
+    std::vector<unsigned int> invalid;
+    for (unsigned int f : staleFrontiers) {
+        unsigned int oldPlate = frontierChangedFrom[f] != noPlate ? frontierChangedFrom[f] : verticesToPlates[f];
+        Plate& plate = plates[oldPlate];
+        auto zone = plate.closestFrontierVertices.find(f);
+        if (zone == plate.closestFrontierVertices.end()) continue;
+        for (unsigned int m : zone->second) {
+            if (closestFrontier[m] != f) continue;
+            closestFrontier[m] = noFrontier;
+            invalid.push_back(m);
+        }
+        plate.closestFrontierVertices.erase(zone);
+    }
+    for (unsigned int v : frontierChanges) {
+        if (closestFrontier[v] == noFrontier) continue;
+        removeFromZone(plates[frontierChangedFrom[v]], closestFrontier[v], v);
+        closestFrontier[v] = noFrontier;
+        invalid.push_back(v);
+    }
+
+    // 3. Travail par plaque : sommets invalidés, nouvelles frontières (distance 0) et,
+    // comme graines, les sommets encore valides au bord de la région invalidée
+    std::vector<unsigned int> repairSlot(plates.size(), noPlate);
+    std::vector<FrontierRepair> repairs;
+    auto repairOf = [&](unsigned int plate) -> FrontierRepair& {
+        if (repairSlot[plate] == noPlate) {
+            repairSlot[plate] = (unsigned int)repairs.size();
+            repairs.push_back(FrontierRepair());
+            repairs.back().plate = plate;
+        }
+        return repairs[repairSlot[plate]];
+    };
+
+    for (unsigned int v : invalid) {
+        mark[v] = 1;
+        frontierDistance[v] = std::numeric_limits<float>::max();
+        repairOf(verticesToPlates[v]).changed.push_back(std::make_pair(v, noFrontier));
+    }
+    for (unsigned int f : newFrontiers) {
+        FrontierRepair& repair = repairOf(verticesToPlates[f]);
+        if (!mark[f]) {
+            mark[f] = 1;
+            repair.changed.push_back(std::make_pair(f, closestFrontier[f]));
+        }
+        closestFrontier[f] = f;
+        frontierDistance[f] = 0.0f;
+        repair.seeds.push_back(FrontierEntry(0.0f, std::make_pair(f, f)));
+    }
+    for (unsigned int v : invalid) {
+        unsigned int plate = verticesToPlates[v];
+        for (unsigned int n : neighbors[v]) {
+            if (verticesToPlates[n] != plate || closestFrontier[n] == noFrontier || mark[n]) continue;
+            repairOf(plate).seeds.push_back(FrontierEntry(frontierDistance[n], std::make_pair(n, closestFrontier[n])));
+        }
+    }
 
-            for (unsigned int frontierIdx : frontierVertices) {
-                float dist = (vertices[vertexIdx] - vertices[frontierIdx]).length();
+    // 4. Propagation et mise à jour des zones, en parallèle : chaque plaque n'écrit que ses sommets
+    parallelFor(0, repairs.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            FrontierRepair& repair = repairs[r];
+            Plate& plate = plates[repair.plate];
+            repairClosestFrontier(*this, repair, mark);
+
+            for (const auto& change : repair.changed) {
+                unsigned int v = change.first;
+                if (change.second == closestFrontier[v]) continue;
+                if (change.second != noFrontier) removeFromZone(plate, change.second, v);
+                if (closestFrontier[v] != noFrontier) plate.closestFrontierVertices[closestFrontier[v]].push_back(v);
+            }
 
-                if (dist < minDist) {
-                    minDist = dist;
-                    closestFrontier = frontierIdx;
+            // Composante de la plaque sans frontière atteignable : recherche directe
+            for (const auto& change : repair.changed) {
+                unsigned int v = change.first;
+                mark[v] = 0;
+                if (closestFrontier[v] != noFrontier) continue;
+                float minDist = std::numeric_limits<float>::max();
+                for (const auto& pair : plate.closestFrontierVertices) {
+                    float dist = (vertices[v] - vertices[pair.first]).length();
+                    if (dist < minDist) {
+                        minDist = dist;
+                        closestFrontier[v] = pair.first;
+                    }
                 }
+                frontierDistance[v] = minDist;
+                if (closestFrontier[v] != noFrontier) plate.closestFrontierVertices[closestFrontier[v]].push_back(v);
             }
-            newMapping[closestFrontier].push_back(vertexIdx);
         }
-        plate.closestFrontierVertices = newMapping;
-    }
+    });
+
+    for (unsigned int v : frontierChanges) frontierChangedFrom[v] = noPlate;
+    frontierChanges.clear();
 }
 
 void Planet::printCrustAt(unsigned int vertex_index) {
@@ -246,35 +467,9 @@ void Planet::assignCrustParameters() {
     const float ocean_depth_range = std::abs(min_elevation);  // 8000.0f
     const float continent_height_range = max_elevation;        // 8000.0f
 
-    // Build mapping vertex -> plate index (if plates exist)
-    std::vector<int> plate_of(vertices.size(), -1);
-    for (size_t p = 0; p < plates.size(); ++p) {
-        for (unsigned int idx : plates[p].vertices_indices) {
-            if (idx < plate_of.size()) plate_of[idx] = static_cast<int>(p);
-        }
-    }
-
-    // build vertex neighbors (adjacency) to detect plate boundaries
-    std::vector<std::vector<unsigned int>> neighbors_local(vertices.size());
-    for (const Triangle& t : triangles) {
-        unsigned int a = t[0], b = t[1], c = t[2];
-        if (a < vertices.size() && b < vertices.size()) {
-            neighbors_local[a].push_back(b);
-            neighbors_local[b].push_back(a);
-        }
-        if (b < vertices.size() && c < vertices.size()) {
-            neighbors_local[b].push_back(c);
-            neighbors_local[c].push_back(b);
-        }
-        if (c < vertices.size() && a < vertices.size()) {
-            neighbors_local[c].push_back(a);
-            neighbors_local[a].push_back(c);
-        }
-    }
-    for (auto& nb : neighbors_local) {
-        std::sort(nb.begin(), nb.end());
-        nb.erase(std::unique(nb.begin(), nb.end()), nb.end());
-    }
+    // frontières de plaques : index maintenu par la planète
+    if (neighbors.size() != vertices.size()) detectVerticesNeighbors();
+    const PlateBoundaryIndex& boundaryVertices = boundary();
 
     // iterate vertices and generate parameters
     for (size_t i = 0; i < vertices.size(); ++i) {
@@ -283,16 +478,7 @@ void Planet::assignCrustParameters() {
         // base noise value [-1, 1]
         float n = noise.GetNoise(p[0], p[1], p[2]);
 
-        bool isBoundary = false;
-        int myPlate = (i < plate_of.size() ? plate_of[i] : -1);
-        if (myPlate >= 0) {
-            for (unsigned int nb : neighbors_local[i]) {
-                if (nb < plate_of.size() && plate_of[nb] != myPlate) {
-                    isBoundary = true;
-                    break;
-                }
-            }
-        }
+        bool isBoundary = !plates.empty() && boundaryVertices.isBoundary((unsigned int)i);
 
         if (n < continent_threshold) {
 
@@ -554,10 +740,88 @@ float Planet::computeMaxDistanceFromOrigin() const {
     return maxDist;
 } 
 
-float Planet::relativeVelocity(Plate & plateA, Plate & plateB) {
+float Planet::relativeVelocity(const Plate & plateA, const Plate & plateB) const {
     float v = std::abs(plateA.plate_velocity - plateB.plate_velocity);
     if (v < 0.0f) v = 0.0f;
     // clamp to max_velocity to keep g() in [0,1]
     if (v > max_velocity) v = max_velocity;
     return v;
-}
\ No newline at end of file
+}
+
+//================================ Repères rigides des plaques ===================================
+
+void Planet::rotatePlate(unsigned int plateIdx, const Quat& rotation) {
+    Plate& plate = plates[plateIdx];
+    plate.frame = rotation * plate.frame;
+    plate.frame.normalize();
+    plate.frameMatrix = plate.frame.toMat3();
+    framesPending = true;
+}
+
+// Noyau de rotation par lot : même matrice pour tous les sommets du lot.
+// Les normales suivent la même rotation (mouvement rigide), pas besoin de recomputeNormals.
+static void rotateVerticesBatch(const Mat3& R, const unsigned int* indices, size_t count,
+                                Vec3* positions, Vec3* normals) {
+    const float r00 = R(0, 0), r01 = R(0, 1), r02 = R(0, 2);
+    const float r10 = R(1, 0), r11 = R(1, 1), r12 = R(1, 2);
+    const float r20 = R(2, 0), r21 = R(2, 1), r22 = R(2, 2);
+
+    for (size_t i = 0; i < count; ++i) {
+        Vec3& p = positions[indices[i]];
+        const float x = p[0], y = p[1], z = p[2];
+        p[0] = r00 * x + r01 * y + r02 * z;
+        p[1] = r10 * x + r11 * y + r12 * z;
+        p[2] = r20 * x + r21 * y + r22 * z;
+    }
+    if (!normals) return;
+    for (size_t i = 0; i < count; ++i) {
+        Vec3& n = normals[indices[i]];
+        const float x = n[0], y = n[1], z = n[2];
+        n[0] = r00 * x + r01 * y + r02 * z;
+        n[1] = r10 * x + r11 * y + r12 * z;
+        n[2] = r20 * x + r21 * y + r22 * z;
+    }
+}
+
+void Planet::materializePositions() {
+    if (!framesPending) return;
+
+    // Découpage en lots de sommets : parallèle entre plaques et à l'intérieur des grosses plaques
+    const size_t batchSize = 4096;
+
+    struct RotationBatch {
+        unsigned int plate;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<RotationBatch> batches;
+    for (unsigned int p = 0; p < plates.size(); ++p) {
+        const Plate& plate = plates[p];
+        if (plate.frame.isIdentity()) continue;
+        for (size_t b = 0; b < plate.vertices_indices.size(); b += batchSize) {
+            batches.push_back(RotationBatch{p, b, std::min(plate.vertices_indices.size(), b + batchSize)});
+        }
+    }
+
+    Vec3* positions = vertices.data();
+    Vec3* normalsData = normals.size() == vertices.size() ? normals.data() : nullptr;
+
+    centroidTracker.applyFrames(*this);
+    plateIndexSet.applyFrames(*this);
+
+    parallelFor(0, batches.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RotationBatch& batch = batches[i];
+            const Plate& plate = plates[batch.plate];
+            rotateVerticesBatch(plate.frameMatrix, plate.vertices_indices.data() + batch.begin,
+                                batch.end - batch.begin, positions, normalsData);
+        }
+    });
+
+    for (Plate& plate : plates) {
+        plate.frame = Quat();
+        plate.frameMatrix = Mat3::Identity();
+    }
+    framesPending = false;
+}
@@ -3,13 +3,19 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <map> 
+#include <map>
+#include <cstdint>
 
 #include "Vec3.h"
 #include "crust.h"
 #include "mesh.h"
 #include "tectonicPhenomenon.h"
 #include "palette.h"
+#include "CentroidTracker.h"
+#include "PlateBoundaryIndex.h"
+#include "BoundaryDistanceField.h"
+#include "PlateIndexSet.h"
+#include "PlateState.h"
 
 //---------------------------------------Planet Class--------------------------------------------
 
@@ -20,7 +26,10 @@ class Plate {
     Vec3 rotation_axis;
     std::map<unsigned int, std::vector<unsigned int>> closestFrontierVertices;
     std::vector<std::vector<unsigned int>> terranes;
-    std::vector<Vec3> terraneCentroids;
+
+    // Rotation accumulée depuis la dernière matérialisation des positions
+    Quat frame;
+    Mat3 frameMatrix = Mat3::Identity();
 
     void fillTerranes(const Planet& planet);
 };
@@ -33,6 +42,10 @@ class Planet : public Mesh {
     std::vector<unsigned int> verticesToPlates;
     std::vector<std::unique_ptr<Crust>> crust_data;
     std::vector<std::vector<unsigned int>> neighbors;
+    // Sommet frontière le plus proche (de sa plaque) et distance, cf. fillClosestFrontierVertices
+    std::vector<unsigned int> closestFrontier;
+    std::vector<float> frontierDistance;
+    bool frontierGeodesic = false;
 
     float max_elevation = 8000.0f;
     float min_elevation = -8000.0f;
@@ -47,13 +60,98 @@ class Planet : public Mesh {
 
     Palette palette;
 
+    // Repères rigides paresseux : vertices[v] contient la position au moment de la
+    // dernière matérialisation, la position courante est plates[p].frame * vertices[v].
+    bool framesPending = false;
+
+    // Centroïdes/aires des plaques et terranes, reconstruits à la demande
+    mutable CentroidTracker centroidTracker;
+    const CentroidTracker& centroids() const {
+        if (!centroidTracker.isValid()) centroidTracker.rebuild(*this);
+        return centroidTracker;
+    }
+
+    // Sommets/arêtes de frontière entre plaques, reconstruits à la demande
+    mutable PlateBoundaryIndex boundaryIndex;
+    const PlateBoundaryIndex& boundary() const {
+        if (!boundaryIndex.isValid()) boundaryIndex.rebuild(*this);
+        return boundaryIndex;
+    }
+
+    // Distance géodésique à la frontière la plus proche, reconstruite à la demande
+    // (à appeler hors des sections parallèles)
+    mutable BoundaryDistanceField boundaryDistanceField;
+    const BoundaryDistanceField& boundaryDistances() const {
+        if (!boundaryDistanceField.isValid()) boundaryDistanceField.rebuild(*this);
+        return boundaryDistanceField;
+    }
+
+    // Index spatial par plaque dans son repère, reconstruit seulement pour les plaques dont
+    // les sommets ont changé (à appeler hors des sections parallèles)
+    mutable PlateIndexSet plateIndexSet;
+    const PlateIndexSet& plateIndices() const {
+        if (!plateIndexSet.isValid()) plateIndexSet.rebuild(*this);
+        return plateIndexSet;
+    }
+
+    // Propriétés des plaques pour le pas courant (construites par Movement::detectPhenomena)
+    PlateStateTable plateStates;
+
+    // Change la plaque d'un sommet en gardant l'index des frontières à jour
+    // (n'ajuste pas vertices_indices ; les positions doivent être matérialisées).
+    // Le changement est noté pour updateFrontierInfluence.
+    void setVertexPlate(unsigned int vertexIdx, unsigned int plateIdx) {
+        boundaryIndex.onVertexPlateChange(*this, vertexIdx, plateIdx);
+        if (verticesToPlates[vertexIdx] != plateIdx) {
+            boundaryDistanceField.invalidate();
+            plateIndexSet.onVertexPlateChange(verticesToPlates[vertexIdx], plateIdx);
+        }
+        if (verticesToPlates[vertexIdx] != plateIdx && frontierChangedFrom.size() == verticesToPlates.size() &&
+            frontierChangedFrom[vertexIdx] == noPlate) {
+            frontierChangedFrom[vertexIdx] = verticesToPlates[vertexIdx];
+            frontierChanges.push_back(vertexIdx);
+        }
+        verticesToPlates[vertexIdx] = plateIdx;
+    }
+
     Planet(float r, int points) : radius(r) {
         setupSphere(radius, points);
     }
 
+    // Position courante d'un sommet, sans forcer la matérialisation de toute la planète
+    Vec3 positionOf(unsigned int v) const {
+        if (!framesPending || v >= verticesToPlates.size()) return vertices[v];
+        unsigned int p = verticesToPlates[v];
+        if (p >= plates.size()) return vertices[v];
+        const Mat3& R = plates[p].frameMatrix;
+        const Vec3& x = vertices[v];
+        return Vec3(R(0, 0) * x[0] + R(0, 1) * x[1] + R(0, 2) * x[2],
+                    R(1, 0) * x[0] + R(1, 1) * x[1] + R(1, 2) * x[2],
+                    R(2, 0) * x[0] + R(2, 1) * x[1] + R(2, 2) * x[2]);
+    }
+
+    void rotatePlate(unsigned int plateIdx, const Quat& rotation);
+    // Applique les repères accumulés aux positions et normales (rendu, rééchantillonnage...)
+    void materializePositions();
+
     void generatePlates(unsigned int n_plates);
     void findFrontierVertices();
-    void fillClosestFrontierVertices();
+    // Propagation multi-sources (Dijkstra) depuis les sommets frontière de chaque plaque,
+    // en parallèle sur les plaques. geodesic : distance le long des arêtes, sinon corde
+    // jusqu'au sommet frontière propagé.
+    void fillClosestFrontierVertices(bool geodesic = false);
+    // Répercute les changements de plaque notés par setVertexPlate sur les sommets frontière
+    // (clés de closestFrontierVertices) et leurs zones : seules les zones touchées sont
+    // invalidées puis repropagées, en O(sommets changés + zones concernées).
+    // Appelée par les opérations qui changent la partition (rifting, nettoyage, migration).
+    void updateFrontierInfluence();
+    // Nouvelle partition sans suivi (rééchantillonnage) : reconstruire avec fillClosestFrontierVertices
+    void invalidateFrontierInfluence() {
+        closestFrontier.clear();
+        frontierDistance.clear();
+        frontierChangedFrom.clear();
+        frontierChanges.clear();
+    }
     void assignCrustParameters();
     void printCrustAt(unsigned int vertex_index);
 
@@ -76,14 +174,29 @@ class Planet : public Mesh {
     void fillAllTerranes();
 
     unsigned int findclosestVertex(const Vec3& point, Planet& srcPlanet);
-    void resample(Planet& srcPlanet);
+    // bandRings > 0 : rééchantillonnage partiel, seuls les sommets à moins de bandRings
+    // arêtes d'une frontière de plaque passent par l'analyse complète du voisinage
+    // scatter : dispersion des sources sur le treillis cible (FibonacciScatter), sans index
+    void resample(Planet& srcPlanet, unsigned int bandRings = 0, bool scatter = false);
     
     void smooth();
     void smoothColors();
     void increaseWaterLevel();
     void decreaseWaterLevel();
-    float relativeVelocity(Plate & plateA, Plate & plateB);
+    float relativeVelocity(const Plate & plateA, const Plate & plateB) const;
+    // Même valeur, lue dans la table du pas quand elle est à jour
+    float plateRelativeSpeed(unsigned int plateA, unsigned int plateB) const {
+        if (plateStates.size() == plates.size() && plateA < plates.size() && plateB < plates.size())
+            return plateStates.relativeSpeed(plateA, plateB);
+        return relativeVelocity(plates[plateA], plates[plateB]);
+    }
 
    private:
+    enum : unsigned int { noPlate = 0xffffffffu };
+    // Ancienne plaque des sommets changés depuis la dernière mise à jour (noPlate sinon)
+    std::vector<unsigned int> frontierChangedFrom;
+    std::vector<unsigned int> frontierChanges;
+    std::vector<uint8_t> frontierMark;  // marques temporaires, remises à 0 après usage
+
     void doSmooth(float lambda);
 };
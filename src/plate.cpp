@@ -8,7 +8,8 @@
 
 void Plate::fillTerranes(const Planet& planet) {
     terranes.clear();
-    terraneCentroids.clear();
+    // les centroïdes des terranes sont suivis par Planet::centroids()
+    planet.centroidTracker.invalidate();
     std::unordered_set<unsigned int> continentalVertices;
     
     for (unsigned int vIdx : vertices_indices) {
@@ -63,31 +64,7 @@ void Plate::fillTerranes(const Planet& planet) {
         
 
         if (terrane.size() >= 20) {
-
-            Vec3 centroid(0.0f, 0.0f, 0.0f);
-
-
-            for (unsigned int vIdx : terrane) {
-                if (vIdx < planet.vertices.size()) {
-                    centroid += planet.vertices[vIdx];
-                } else {
-                    std::cerr << "WARNING: Invalid vertex index " << vIdx 
-                              << " in terrane (max: " << planet.vertices.size() - 1 << ")" << std::endl;
-                }
-            }
-
-            centroid /= (float)terrane.size();
-            
-            centroid.normalize();
-            centroid *= planet.radius;
-            
             terranes.push_back(terrane);
-            terraneCentroids.push_back(centroid);
         }
     }
-
-    if (terranes.size() != terraneCentroids.size()) {
-        std::cerr << "ERROR: Mismatch between terranes and centroids count!" << std::endl;
-    }
-    
 }
\ No newline at end of file
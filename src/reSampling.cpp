@@ -9,18 +9,24 @@
 #include "planet.h"
 #include "crust.h"
 #include "SphericalGrid.h"
+#include "FibonacciScatter.h"
 #include "tectonicPhenomenon.h"
 #include "rifting.h"
 #include "UnionFind.h"
+#include "Arena.h"
+#include "Parallel.h"
 
 
 
 unsigned int Planet::findclosestVertex(const Vec3& point, Planet& srcPlanet){
+    // index par plaque de la source : rien à reconstruire tant que ses plaques ne changent pas
+    if (PlateIndexSet::applicable(srcPlanet)) return srcPlanet.plateIndices().nearest(srcPlanet, point);
+
     unsigned int closestIndex = 0;
     float minDistSq = std::numeric_limits<float>::max();
 
     for (unsigned int i = 0; i < srcPlanet.vertices.size(); ++i) {
-        float distSq = (srcPlanet.vertices[i] - point).squareLength();
+        float distSq = (srcPlanet.positionOf(i) - point).squareLength();
         if (distSq < minDistSq) {
             minDistSq = distSq;
             closestIndex = i;
@@ -30,43 +36,54 @@ unsigned int Planet::findclosestVertex(const Vec3& point, Planet& srcPlanet){
     return closestIndex;
 }
 
-void computeCrustGenerationEvent(Planet& targetPlanet, Planet& srcPlanet,SphericalKDTree &accel, unsigned int vertexIndex, unsigned int closestIndex) { // Compute and trigger a crust generation event during resampling
-        Vec3 currentVertex = targetPlanet.vertices[vertexIndex];
-        std::pair<uint32_t, uint32_t> nearestDifferentPlates = accel.nearestFromDifferentPlates(currentVertex, srcPlanet);
-        
-        // Calculer le point milieu sur la ridge
-        Vec3 q = (srcPlanet.vertices[nearestDifferentPlates.first] + srcPlanet.vertices[nearestDifferentPlates.second]) * 0.5f;
-        
-        Vec3 closestPlateBoundary = srcPlanet.vertices[nearestDifferentPlates.first];
-
-        crustGeneration crustGenerationEvent(
-            srcPlanet.verticesToPlates[nearestDifferentPlates.first],
-            srcPlanet.verticesToPlates[nearestDifferentPlates.second],
-            vertexIndex,
-            0.02f,
-            closestPlateBoundary,
-            q,
-            "Auto-generated rifting event during resampling"
-        );
-
-        crustGenerationEvent.triggerEvent(targetPlanet);
+// Remplissage des trous de divergence en un seul passage, après la boucle de
+// rééchantillonnage : les sommets cible sans sommet source proche (gaps) reçoivent une
+// croûte océanique générée depuis la ride entre les deux plaques qui s'écartent.
+// ridgePairs[g] : (plus proche source, plus proche source sur une autre plaque) de gaps[g]
+static void fillDivergentGaps(Planet& targetPlanet, Planet& srcPlanet, const std::vector<unsigned int>& gaps,
+                              const std::vector<std::pair<uint32_t, uint32_t>>& ridgePairs) {
+    if (gaps.empty()) return;
+
+    // Écriture de la croûte océanique, chaque sommet indépendamment
+    parallelFor(0, gaps.size(), 256, [&](size_t begin, size_t end) {
+        for (size_t g = begin; g < end; ++g) {
+            unsigned int v = gaps[g];
+            unsigned int first = ridgePairs[g].first;
+            unsigned int second = ridgePairs[g].second;
+
+            // point milieu sur la ride, distance à la frontière depuis le sommet source le plus proche
+            Vec3 q = (srcPlanet.vertices[first] + srcPlanet.vertices[second]) * 0.5f;
+            Vec3 closestPlateBoundary = srcPlanet.vertices[first];
+
+            TectonicPhenomenon crustGenerationEvent = TectonicPhenomenon::crustGeneration(
+                srcPlanet.verticesToPlates[first],
+                srcPlanet.verticesToPlates[second],
+                v,
+                0.02f,
+                "Auto-generated rifting event during resampling"
+            );
+            triggerCrustGeneration(crustGenerationEvent, targetPlanet, q, closestPlateBoundary);
+        }
+    });
 }
 
+std::unique_ptr<Crust> cloneCrust(const Crust* srcCrust);
+
+// neighbors : les plus proches sources de la cible, par distance croissante
 std::unique_ptr<Crust> copyCrust(Planet& srcPlanet, unsigned int closestIndex, 
-                                  SphericalKDTree& accel, const Vec3& currentVertex) { 
+                                  const uint32_t* neighbors, unsigned int neighborCount) { 
     std::unique_ptr<Crust> crust_data;
 
     const Crust* srcCrust = srcPlanet.crust_data[closestIndex].get();
     
     // Vérifier si on est dans une zone de subduction océanique-continentale
-    std::vector<unsigned int> neighbors = accel.kNearest(currentVertex, 2);
-    
     bool hasOceanic = false;
     bool hasContinental = false;
     unsigned int continentalIndex = closestIndex;
     
 
-    for (unsigned int neighborIdx : neighbors) {
+    for (unsigned int n = 0; n < neighborCount; ++n) {
+        unsigned int neighborIdx = neighbors[n];
         if (neighborIdx >= srcPlanet.crust_data.size() || !srcPlanet.crust_data[neighborIdx]) {
             continue;
         }
@@ -87,8 +104,8 @@ std::unique_ptr<Crust> copyCrust(Planet& srcPlanet, unsigned int closestIndex,
         bool isDifferentPlates = false;
         unsigned int closestPlate = srcPlanet.verticesToPlates[closestIndex];
         
-        for (unsigned int neighborIdx : neighbors) {
-            if (srcPlanet.verticesToPlates[neighborIdx] != closestPlate) {
+        for (unsigned int n = 0; n < neighborCount; ++n) {
+            if (srcPlanet.verticesToPlates[neighbors[n]] != closestPlate) {
                 isDifferentPlates = true;
                 break;
             }
@@ -101,6 +118,13 @@ std::unique_ptr<Crust> copyCrust(Planet& srcPlanet, unsigned int closestIndex,
         }
     }
     
+    return cloneCrust(srcCrust);
+}
+
+// Copie d'une croûte source (sans analyse du voisinage)
+std::unique_ptr<Crust> cloneCrust(const Crust* srcCrust) {
+    std::unique_ptr<Crust> crust_data;
+
     //copy crust
     const OceanicCrust* oc = dynamic_cast<const OceanicCrust*>(srcCrust);
     if (oc) {
@@ -138,17 +162,19 @@ std::unique_ptr<Crust> copyCrust(Planet& srcPlanet, unsigned int closestIndex,
 }
 
  // threshold is kneighbors
-unsigned int computePlateIndex(SphericalKDTree &accel, Planet &srcPlanet, unsigned int closestIndex, const Vec3 &currentVertex, int threshold = 3) {
+unsigned int computePlateIndex(Planet &srcPlanet, unsigned int closestIndex, const uint32_t* neighbors,
+                               unsigned int neighborCount, int threshold = 3) {
     unsigned int closestPlate = srcPlanet.verticesToPlates[closestIndex];
 
-    std::vector<unsigned int> neighbors = accel.kNearest(currentVertex, 8);
-
-    if (neighbors.empty()) {
+    if (neighborCount == 0) {
         return closestPlate; 
     }
 
-    std::map<unsigned int, int> plateVotes;
-    for (unsigned int neighborIdx : neighbors) {
+    // table de votes temporaire : rendue à l'arène en fin de requête
+    StepArena::Scope scope(StepArena::stepArena());
+    ArenaMap<unsigned int, int> plateVotes;
+    for (unsigned int n = 0; n < neighborCount; ++n) {
+        unsigned int neighborIdx = neighbors[n];
         if (neighborIdx >= srcPlanet.verticesToPlates.size()) continue;
         if (neighborIdx == closestIndex) continue; // evitar doble conteo
 
@@ -277,7 +303,7 @@ void cleanPlatesFast(Planet& planet, size_t minIslandSize) {
         
         
         for (unsigned int vertexIdx : vertices) {
-            planet.verticesToPlates[vertexIdx] = newPlateId;
+            planet.setVertexPlate(vertexIdx, newPlateId);
         }
         
         totalCleaned += componentSize;
@@ -294,6 +320,8 @@ void cleanPlatesFast(Planet& planet, size_t minIslandSize) {
             planet.plates[plateId].vertices_indices.push_back(i);
         }
     }
+    planet.centroidTracker.invalidate();
+    planet.updateFrontierInfluence();
     
     auto t_end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count();
@@ -305,19 +333,68 @@ void cleanPlatesFast(Planet& planet, size_t minIslandSize) {
 
 //================================ Planet Resampling ===================================
 
-void Planet::resample(Planet& srcPlanet) {
+// Sommets source à au plus bandRings arêtes d'une frontière de plaque. Les intérieurs des
+// plaques bougent rigidement : hors de cette bande le maillage source n'est pas déformé.
+static std::vector<uint8_t> distortedRegion(Planet& srcPlanet, unsigned int bandRings) {
+    size_t N = srcPlanet.vertices.size();
+    std::vector<uint8_t> distorted(N, 0);
+
+    std::vector<unsigned int> front(srcPlanet.boundary().vertices());
+    for (unsigned int v : front) distorted[v] = 1;
+
+    std::vector<unsigned int> next;
+    for (unsigned int ring = 0; ring < bandRings && !front.empty(); ++ring) {
+        next.clear();
+        for (unsigned int v : front) {
+            for (unsigned int n : srcPlanet.neighbors[v]) {
+                if (distorted[n]) continue;
+                distorted[n] = 1;
+                next.push_back(n);
+            }
+        }
+        front.swap(next);
+    }
+    return distorted;
+}
+
+void Planet::resample(Planet& srcPlanet, unsigned int bandRings, bool scatter) {
     
     auto t_total_start = std::chrono::steady_clock::now();
 
+    // les plaques source peuvent avoir des rotations en attente
+    srcPlanet.materializePositions();
+
+    // Rééchantillonnage partiel : seule la bande autour des frontières est reprojetée
+    // avec l'analyse du voisinage, les intérieurs sont repris par indice
+    bool partial = bandRings > 0 && srcPlanet.neighbors.size() == srcPlanet.vertices.size();
+    std::vector<uint8_t> distorted;
+    if (partial) distorted = distortedRegion(srcPlanet, bandRings);
+    size_t interiorCount = 0;
+
     size_t N = vertices.size();
     crust_data.resize(N);
     verticesToPlates.resize(N);
 
-    std::vector<Vec3> srcVerticesCopy = srcPlanet.vertices;
-
-    SphericalKDTree accel(srcVerticesCopy, srcPlanet);
+    // voisins du treillis cible : ne dépendent que des triangles
+    detectVerticesNeighbors();
 
-    printf("SphericalKDTree built with %zu vertices\n", srcVerticesCopy.size());
+    // Correspondance cible → sources : dispersion sur le treillis cible, ou index sur les sources
+    // (index par plaque de la source : déjà construit si ses plaques n'ont pas changé)
+    std::unique_ptr<FibonacciScatter> scattered;
+    const PlateIndexSet* plateIndices = nullptr;
+    std::unique_ptr<SphericalKDTree> accel;
+    if (scatter && FibonacciScatter::applicable(*this)) {
+        scattered.reset(new FibonacciScatter(*this, srcPlanet));
+        printf("Scattered %zu source vertices (%zu empty cells, %zu crowded)\n", srcPlanet.vertices.size(),
+               scattered->emptyCells(), scattered->crowdedCells());
+    } else if (PlateIndexSet::applicable(srcPlanet)) {
+        plateIndices = &srcPlanet.plateIndices();
+        printf("Per-plate indices over %zu plates\n", srcPlanet.plates.size());
+    } else {
+        std::vector<Vec3> srcVerticesCopy = srcPlanet.vertices;
+        accel.reset(new SphericalKDTree(srcVerticesCopy, srcPlanet));
+        printf("SphericalKDTree built with %zu vertices\n", srcVerticesCopy.size());
+    }
 
     float expected_area = 4.0f * M_PI / float(srcPlanet.vertices.size());
     float expected_spacing = std::sqrt(expected_area);
@@ -326,18 +403,66 @@ void Planet::resample(Planet& srcPlanet) {
     std::cout << "Expected spacing: " << expected_spacing << ", expected chord^2: " << expected_chord2 << std::endl;
 
 
+    // Requêtes groupées : plus proche source de chaque cible, puis 8 plus proches pour
+    // les cibles qui demandent l'analyse du voisinage
+    std::vector<uint32_t> closest(N);
+    if (scattered) scattered->nearest(closest.data());
+    else if (plateIndices) plateIndices->nearestBatch(srcPlanet, vertices.data(), N, closest.data());
+    else accel->nearestBatch(vertices.data(), N, closest.data());
+
+    std::vector<uint32_t> analysed;
+    for (size_t i = 0; i < N; ++i) {
+        float dist2 = (srcPlanet.vertices[closest[i]] - vertices[i]).squareLength();
+        if (partial && !distorted[closest[i]] && dist2 <= expected_chord2) continue;
+        analysed.push_back((uint32_t)i);
+    }
+
+    const unsigned int kVotes = 8;
+    std::vector<uint32_t> analysedNeighbors(analysed.size() * kVotes);
+    if (scattered) {
+        scattered->kNearest(analysed, kVotes, analysedNeighbors.data());
+    } else {
+        std::vector<Vec3> analysedVertices(analysed.size());
+        for (size_t a = 0; a < analysed.size(); ++a) analysedVertices[a] = vertices[analysed[a]];
+        if (plateIndices) {
+            plateIndices->kNearestBatch(srcPlanet, analysedVertices.data(), analysedVertices.size(), kVotes,
+                                        analysedNeighbors.data());
+        } else {
+            accel->kNearestBatch(analysedVertices.data(), analysedVertices.size(), kVotes, analysedNeighbors.data());
+        }
+    }
+
+    std::vector<unsigned int> gaps;
+    size_t nextAnalysed = 0;
+
     for(int i = 0; i < N; ++i) {
         Vec3 currentVertex = vertices[i];
-        unsigned int closestIndex = accel.nearest(currentVertex);
+        unsigned int closestIndex = closest[i];
+
+        float dist2 = (srcPlanet.vertices[closestIndex] - currentVertex).squareLength();
+
+        if (nextAnalysed == analysed.size() || analysed[nextAnalysed] != (uint32_t)i) {
+            // intérieur d'une plaque : même résultat que l'analyse complète (voisins sur la même plaque)
+            if (closestIndex < srcPlanet.crust_data.size() && srcPlanet.crust_data[closestIndex]) {
+                crust_data[i] = cloneCrust(srcPlanet.crust_data[closestIndex].get());
+            }
+            verticesToPlates[i] = srcPlanet.verticesToPlates[closestIndex];
+            interiorCount++;
+            continue;
+        }
+
+        const uint32_t* neighbors = &analysedNeighbors[nextAnalysed * kVotes];
+        nextAnalysed++;
+        unsigned int neighborCount = 0;
+        while (neighborCount < kVotes && neighbors[neighborCount] != SphericalKDTree::noIndex) neighborCount++;
 
-        if((srcPlanet.vertices[closestIndex] - currentVertex).squareLength() > expected_chord2) {
-            float dist2 = (srcPlanet.vertices[closestIndex] - currentVertex).squareLength();
-            computeCrustGenerationEvent(*this, srcPlanet, accel, i, closestIndex);
+        if(dist2 > expected_chord2) {
+            gaps.push_back(i);  // croûte générée après la boucle (fillDivergentGaps)
         } else if (closestIndex < srcPlanet.crust_data.size() && srcPlanet.crust_data[closestIndex]) {
-            crust_data[i] = copyCrust(srcPlanet, closestIndex, accel, currentVertex);
+            crust_data[i] = copyCrust(srcPlanet, closestIndex, neighbors, std::min(neighborCount, 2u));
         }
 
-        unsigned int plateIndex = computePlateIndex(accel, srcPlanet, closestIndex, currentVertex);
+        unsigned int plateIndex = computePlateIndex(srcPlanet, closestIndex, neighbors, neighborCount);
         
         verticesToPlates[i] = plateIndex;
 
@@ -346,6 +471,26 @@ void Planet::resample(Planet& srcPlanet) {
         }
     }
 
+    if (partial) {
+        printf("Partial resampling: %zu/%zu interior vertices remapped directly (band %u rings)\n",
+               interiorCount, N, bandRings);
+    }
+
+    // Paires de ride des trous
+    std::vector<std::pair<uint32_t, uint32_t>> ridgePairs(gaps.size());
+    if (scattered) {
+        scattered->nearestFromDifferentPlates(gaps, ridgePairs);
+    } else if (plateIndices) {
+        for (unsigned int g = 0; g < gaps.size(); ++g) {
+            ridgePairs[g] = plateIndices->nearestFromDifferentPlates(srcPlanet, vertices[gaps[g]]);
+        }
+    } else {
+        for (unsigned int g = 0; g < gaps.size(); ++g) {
+            ridgePairs[g] = accel->nearestFromDifferentPlates(vertices[gaps[g]], srcPlanet);
+        }
+    }
+    fillDivergentGaps(*this, srcPlanet, gaps, ridgePairs);
+
     plates.resize(srcPlanet.plates.size());
     for(size_t i = 0; i < vertices.size(); ++i) {
         unsigned int plateIndex = verticesToPlates[i];
@@ -358,9 +503,11 @@ void Planet::resample(Planet& srcPlanet) {
         plates[i].plate_velocity = srcPlanet.plates[i].plate_velocity;
         plates[i].rotation_axis = srcPlanet.plates[i].rotation_axis;
     }
-
-    detectVerticesNeighbors();
-    
+    centroidTracker.invalidate();
+    boundaryIndex.invalidate();
+    boundaryDistanceField.invalidate();
+    plateIndexSet.invalidate();
+    invalidateFrontierInfluence();
     
     cleanPlatesFast(*this, N/100);
     
@@ -380,13 +527,10 @@ void Planet::resample(Planet& srcPlanet) {
         bool riftSuccess = rifter.triggerRifting(*this);
 
         if (riftSuccess) {
-            detectVerticesNeighbors();
-            
+            detectVerticesNeighbors();            
             // ===== OPTIONNEL: Nettoyer après le rifting aussi =====
             cleanPlatesFast(*this, 20);
-            
-            findFrontierVertices();
-            fillClosestFrontierVertices();
+
             fillAllTerranes();
         }
     }
@@ -11,6 +11,9 @@ bool PlateRifting::triggerRifting(Planet& planet) {
         std::cout << "No plates to rift." << std::endl;
         return false;
     }
+
+    // le découpage se fait sur les positions monde
+    planet.materializePositions();
     
     unsigned int selectedPlate;
     size_t greatestPlateSize = 0;
@@ -116,6 +119,7 @@ std::vector<unsigned int> PlateRifting::assignToVoronoiCells(
 }
 
 void PlateRifting::warpBoundaries(std::vector<unsigned int>& assignments,
+                                  const std::vector<unsigned int>& plateVertices,
                                   const Planet& planet,
                                   float warpStrength) {
     std::random_device rd;
@@ -123,27 +127,26 @@ void PlateRifting::warpBoundaries(std::vector<unsigned int>& assignments,
     std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     
 
-    std::vector<bool> isBoundary(planet.vertices.size(), false);
-    
-    for (size_t i = 0; i < planet.vertices.size(); ++i) {
-        if (i >= planet.neighbors.size()) continue;
+    // Seuls les sommets de la plaque découpée comptent : on ne parcourt qu'eux,
+    // par indice croissant (la perturbation est séquentielle)
+    std::vector<unsigned int> boundaryVertices;
+    for (unsigned int i : plateVertices) {
+        if (i >= planet.neighbors.size() || i >= assignments.size()) continue;
         
         unsigned int myCell = assignments[i];
         
         for (unsigned int neighbor : planet.neighbors[i]) {
             if (neighbor < assignments.size() && assignments[neighbor] != myCell) {
-                isBoundary[i] = true;
+                boundaryVertices.push_back(i);
                 break;
             }
         }
     }
+    std::sort(boundaryVertices.begin(), boundaryVertices.end());
     
 
-    for (size_t i = 0; i < planet.vertices.size(); ++i) {
-        if (!isBoundary[i]) continue;
-        
-
-        if (dist(gen) < warpStrength && i < planet.neighbors.size()) {
+    for (unsigned int i : boundaryVertices) {
+        if (dist(gen) < warpStrength) {
             std::vector<unsigned int> neighborCells;
             
             for (unsigned int neighbor : planet.neighbors[i]) {
@@ -202,7 +205,7 @@ bool PlateRifting::riftPlate(Planet& planet, unsigned int plateIndex, unsigned i
     );
     
     
-    warpBoundaries(assignments, planet, 0.01f);
+    warpBoundaries(assignments, originalPlate.vertices_indices, planet, 0.01f);
     
     
     std::vector<std::vector<unsigned int>> newPlatesVertices(numFragments);
@@ -248,13 +251,12 @@ bool PlateRifting::riftPlate(Planet& planet, unsigned int plateIndex, unsigned i
 
     for (unsigned int vIdx : originalPlate.vertices_indices) {
         if (vIdx < planet.verticesToPlates.size()) {
-            planet.verticesToPlates[vIdx] = plateIndex;
+            planet.setVertexPlate(vIdx, plateIndex);
         }
     }
     
 
     originalPlate.terranes.clear();
-    originalPlate.terraneCentroids.clear();
     originalPlate.fillTerranes(planet);
     
 
@@ -279,13 +281,15 @@ bool PlateRifting::riftPlate(Planet& planet, unsigned int plateIndex, unsigned i
 
         for (unsigned int vIdx : newPlate.vertices_indices) {
             if (vIdx < planet.verticesToPlates.size()) {
-                planet.verticesToPlates[vIdx] = newPlateIndex;
+                planet.setVertexPlate(vIdx, newPlateIndex);
             }
         }
         
         planet.plates[newPlateIndex].fillTerranes(planet);
         
     }
+
+    planet.updateFrontierInfluence();
     
     std::cout << "Rifting completed! Total plates: " << planet.plates.size() << std::endl;
     std::cout << "========================================\n" << std::endl;
@@ -23,6 +23,7 @@ private:
         const std::vector<Vec3>& centroids);
     
     static void warpBoundaries(std::vector<unsigned int>& assignments,
+                              const std::vector<unsigned int>& plateVertices,
                               const Planet& planet,
                               float warpStrength = 0.3f);
 };
\ No newline at end of file
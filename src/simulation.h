@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Vec3.h"
+#include "planet.h"
+#include "movement.h"
+#include "erosion.h"
+#include "DistortionMonitor.h"
+
+// Boucle de simulation fusionnée pour enchaîner plusieurs pas entre deux rééchantillonnages.
+// Donne exactement le même résultat que la séquence movePlates() + erosion() répétée,
+// mais avec moins de passes sur les sommets :
+//  - le déplacement ne touche que les repères des plaques (O(plaques)),
+//  - les centroïdes des plaques viennent du CentroidTracker (aucune passe sur les sommets),
+//  - l'érosion du pas précédent est faite dans la même passe (parallèle) que la
+//    classification des frontières (la détection ne lit pas l'élévation),
+//  - les événements sont appliqués en bloc après la détection.
+// La distorsion des frontières est mesurée après chaque pas (cf. DistortionMonitor) :
+// needsResample() indique quand rééchantillonner.
+class Simulation {
+   public:
+    Movement& movement;
+    Erosion& erosion;
+    float timeStep = 1.0f;
+    DistortionMonitor distortion;
+
+    Simulation(Movement& m, Erosion& e) : movement(m), erosion(e) {}
+
+    void advance(unsigned int nSteps) {
+        if (nSteps == 0) return;
+        Planet& planet = *movement.planet;
+
+        for (unsigned int step = 0; step < nSteps; ++step) {
+            movement.beginStep(timeStep);
+
+            // Érosion du pas précédent fusionnée avec la détection, bloc par bloc
+            if (step > 0) {
+                movement.tectonicPhenomena = movement.detectPhenomena([&](size_t begin, size_t end) {
+                    for (size_t v = begin; v < end; ++v) erosion.erodeCrust(*planet.crust_data[v]);
+                });
+                if (planet.plates.empty()) erosion.erosion();
+            } else {
+                movement.tectonicPhenomena = movement.detectPhenomena();
+            }
+
+            movement.triggerEvents();
+            distortion.observe(planet);
+        }
+
+        // Érosion du dernier pas
+        erosion.erosion();
+    }
+
+    bool needsResample() const { return distortion.needsResample(); }
+
+    // À appeler après chaque rééchantillonnage
+    void onResample(const Planet& planet) { distortion.reset(planet); }
+};
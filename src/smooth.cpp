@@ -81,5 +81,7 @@ void Planet::doSmooth(float lambda) {
 
         vertices = newVertices;
     }
+    // déformation non rigide
+    plateIndexSet.invalidate();
 
 }
\ No newline at end of file
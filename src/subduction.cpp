@@ -6,51 +6,66 @@
 
 #include "tectonicPhenomenon.h"
 #include "planet.h"
+#include "UpliftProfiles.h"
 
 float subductionUplift = 1000.0f;
 
-void Subduction::triggerEvent(Planet& planet) {
+// Atténuation selon l'élévation du sommet soulevé (< 2000, >= 2000, >= 4000, >= 6000 m)
+static const DampingBands subductionDamping = {{1.0f, 0.8f, 0.5f, 0.2f}};
+
+void subductionUpliftBatch(const float* distSq, const float* elevation, size_t n,
+                           float v, float z, float* uplift) {
+    typedef TectonicPhenomenon P;
+    UpliftProfiles::falloffBatch(distSq, n, 1.0f / (P::r_s * P::r_s), uplift);
+    float scale = P::g(v) * P::h(z);
+    for (size_t i = 0; i < n; ++i) uplift[i] = subductionUplift * uplift[i] * scale;
+    UpliftProfiles::dampingBatch(subductionDamping, elevation, n, uplift);
+}
+
+void evaluateSubduction(const BoundarySegment& segment, unsigned int phenomenonVertexIndex,
+                        const Planet& planet, UpliftBuffer& uplift) {
+    typedef TectonicPhenomenon P;
+    unsigned int plate_under = segment.summary.plate_under;
+    unsigned int plate_over = segment.summary.plate_over;
 
     float minZ = planet.min_elevation; 
     float maxZ = planet.max_elevation; 
     //std::cout << "Subduction event triggered at vertex " << getVertexIndex() << " between plates " << getPlateA() << " and " << getPlateB() << std::endl;
-    Plate& plateUnder = planet.plates[plate_under];
-    Plate& plateOver = planet.plates[plate_over];
+    const Plate& plateOver = planet.plates[plate_over];
 
-    unsigned int phenomenonVertexIndex = getVertexIndex();
-    
+    auto zone = plateOver.closestFrontierVertices.find(phenomenonVertexIndex);
+    if (zone == plateOver.closestFrontierVertices.end()) return;
 
-    std::vector<unsigned int> verticesClosestToPhenomenon = plateOver.closestFrontierVertices[phenomenonVertexIndex];
-    for (unsigned int vertexIndex : verticesClosestToPhenomenon) {
-        unsigned int vertex_plate = planet.verticesToPlates[vertexIndex];
+    float v = planet.plateRelativeSpeed(plate_under, plate_over);
 
-        if (plate_under == vertex_plate) {
-            planet.crust_data[vertexIndex]->is_under_subduction = true;
-            continue; // We don't care about the plate that is under
-        }
+    const BoundaryDistanceField& field = planet.boundaryDistances();
+    float z = P::elevationImpact(planet.crust_data[phenomenonVertexIndex]->relief_elevation, minZ, maxZ); // TODO: this should not be the elevation on the contact point. It should be the one of the plate that is under the current vertex
 
-        Vec3 vertex = planet.vertices[vertexIndex];
-        Vec3 subductionVertex = planet.vertices[phenomenonVertexIndex];
-        float d = distanceToInteractionFront(vertex, subductionVertex);
-        float v = planet.relativeVelocity(plateUnder, plateOver);
-        float z = elevationImpact(planet.crust_data[phenomenonVertexIndex]->relief_elevation, minZ, maxZ); // TODO: this should not be the elevation on the contact point. It should be the one of the plate that is under the current vertex
+    // Évaluation par lots de upliftBatchSize sommets
+    unsigned int indices[upliftBatchSize];
+    float distSq[upliftBatchSize];
+    float elevation[upliftBatchSize];
+    float newElevation[upliftBatchSize];
+    size_t n = 0;
+    auto flush = [&]() {
+        subductionUpliftBatch(distSq, elevation, n, v, z, newElevation);
+        for (size_t i = 0; i < n; ++i) uplift.push_back(UpliftDelta{indices[i], newElevation[i], false});
+        n = 0;
+    };
 
-        
-
-        float newElevation = subductionUplift * f(d) * g(v) * h(z);
+    for (unsigned int vertexIndex : zone->second) {
+        unsigned int vertex_plate = planet.verticesToPlates[vertexIndex];
 
-        if(planet.crust_data[vertexIndex]->relief_elevation >= 6000.0f){
-            newElevation *= 0.2f; 
-        }else if(planet.crust_data[vertexIndex]->relief_elevation >= 4000.0f){
-            newElevation *= 0.5f; 
-        }
-        else if(planet.crust_data[vertexIndex]->relief_elevation >= 2000.0f){
-            newElevation *= 0.8f; 
+        if (plate_under == vertex_plate) {
+            uplift.push_back(UpliftDelta{vertexIndex, 0.0f, true});
+            continue; // We don't care about the plate that is under
         }
 
-        planet.crust_data[vertexIndex]->relief_elevation += newElevation;
-        
-        //std::cout << " - Vertex " << vertexIndex << " elevated by " << newElevation << " to " << planet.crust_data[vertexIndex]->relief_elevation << std::endl;
+        indices[n] = vertexIndex;
+        float d = field.distance(vertexIndex);
+        distSq[n] = d * d;
+        elevation[n] = planet.crust_data[vertexIndex]->relief_elevation;
+        if (++n == upliftBatchSize) flush();
     }
-    
-}
\ No newline at end of file
+    flush();
+}
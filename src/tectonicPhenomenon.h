@@ -4,163 +4,160 @@
 #include <vector>
 
 #include "Vec3.h"
+#include "Arena.h"
+#include "UpliftProfiles.h"
 
 class Planet; // forward declaration to avoid circular include with planet.h
 
-class TectonicPhenomenon {
-   public:
+// Un phénomène est un simple enregistrement (type + champs), stocké par valeur dans un
+// vecteur contigu : pas de hiérarchie virtuelle, pas d'allocation par phénomène.
+// Les événements sont appliqués par segment de frontière (cf. BoundarySegment) et la
+// description n'est construite qu'à l'affichage.
+struct TectonicPhenomenon {
     enum class Type : uint8_t {
         Subduction,
         ContinentalCollision,
         crustGeneration
     };
 
-    TectonicPhenomenon(Type t, unsigned int plateA, unsigned int plateB, unsigned int vertexIndex)
-        : type(t), plate_a(plateA), plate_b(plateB), vertex_index(vertexIndex) {}
-
-    virtual ~TectonicPhenomenon() = default;
-
-    // Accès commun aux informations de base
-    Type getType() const { return type; }
-    unsigned int getPlateA() const { return plate_a; }
-    unsigned int getPlateB() const { return plate_b; }
-    unsigned int getVertexIndex() const { return vertex_index; }
-
-    // Méthode virtuelle pure pour obtenir une description spécifique
-    virtual std::string getDescription() const = 0;
-    virtual void triggerEvent(Planet & planet) = 0;
+    enum class SubductionType : uint8_t {
+        Oceanic_Oceanic,
+        Oceanic_Continental,
+        Continental_Continental
+    };
 
-   protected:
     Type type;
+    SubductionType subduction_type;  // Subduction uniquement
     unsigned int plate_a;
     unsigned int plate_b;
     unsigned int vertex_index;
-
-    float r_s = 0.1f; // Distance that impacts uplift effect
-    float max_velocity = 2.0f; // TODO: idk, Timothée knows -> In fact Timothée doesn't know either
-
-    float f(float d) {
-        if (d <= 0.0f) return 1.0f;
-        if (d >= r_s) return 0.0f;
-
-        float x = d / r_s;
-
-        return 1.0f - 3.0f * x * x + 2.0f * x * x * x; // TODO: maybe this is not accurate, need to see the function shape
-    }
-
-    float g(float v) {
-        return v/max_velocity;
-    }
-
-    float h(float z) {
-        return z ;
+    unsigned int plate_under;        // Subduction uniquement
+    unsigned int plate_over;         // Subduction uniquement
+    float magnitude;                 // convergence (subduction, collision) ou divergence
+    const char* reason;              // littéral statique
+
+    static TectonicPhenomenon subduction(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
+                                         unsigned int plateUnder, unsigned int plateOver, float convergenceRate,
+                                         SubductionType subductionType, const char* reason) {
+        return TectonicPhenomenon{Type::Subduction, subductionType, plateA, plateB, vertexIndex,
+                                  plateUnder, plateOver, convergenceRate, reason};
     }
 
-    float elevationImpact(float z, float minZ, float maxZ) {
-        if (maxZ <= minZ) return 0.0f;
-        float normalizedZ = (z - minZ) / (maxZ - minZ);
-        if (normalizedZ < 0.0f) normalizedZ = 0.0f;
-        if (normalizedZ > 1.0f) normalizedZ = 1.0f;
-        return normalizedZ;
+    static TectonicPhenomenon continentalCollision(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
+                                                   float collisionMagnitude, const char* description) {
+        return TectonicPhenomenon{Type::ContinentalCollision, SubductionType::Continental_Continental,
+                                  plateA, plateB, vertexIndex, plateA, plateB, collisionMagnitude, description};
     }
 
-    float distanceToInteractionFront(Vec3 p, Vec3 subductionFront) {
-        Vec3 distance = p - subductionFront;
-        return distance.length();
+    static TectonicPhenomenon crustGeneration(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
+                                              float divergenceRate, const char* description) {
+        return TectonicPhenomenon{Type::crustGeneration, SubductionType::Oceanic_Oceanic,
+                                  plateA, plateB, vertexIndex, plateA, plateB, divergenceRate, description};
     }
-};
-
-class Subduction : public TectonicPhenomenon {
-   public:
-    enum class SubductionType : uint8_t {
-        Oceanic_Oceanic,
-        Oceanic_Continental,
-        Continental_Continental
-    };
-
-    Subduction(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
-               unsigned int plateUnder, unsigned int plateOver, float convergenceRate,
-               SubductionType subductionType, const std::string& reason)
-        : TectonicPhenomenon(Type::Subduction, plateA, plateB, vertexIndex),
-          plate_under(plateUnder),
-          plate_over(plateOver),
-          convergence(convergenceRate),
-          subduction_type(subductionType),
-          reason(reason) {}
 
+    // Accès commun aux informations de base
+    Type getType() const { return type; }
+    unsigned int getPlateA() const { return plate_a; }
+    unsigned int getPlateB() const { return plate_b; }
+    unsigned int getVertexIndex() const { return vertex_index; }
     unsigned int getPlateUnder() const { return plate_under; }
     unsigned int getPlateOver() const { return plate_over; }
-    float getConvergence() const { return convergence; }
     SubductionType getSubductionType() const { return subduction_type; }
+    float getConvergence() const { return magnitude; }
+    float getMagnitude() const { return magnitude; }
+    float getDivergence() const { return magnitude; }
+
+    std::string getDescription() const {
+        switch (type) {
+            case Type::Subduction:
+                return "Subduction: " + std::string(reason) + " (Convergence: " + std::to_string(magnitude) + ")";
+            case Type::ContinentalCollision:
+                return "Continental Collision: " + std::string(reason) + " (Magnitude: " + std::to_string(magnitude) + ")";
+            case Type::crustGeneration:
+                return "crustGeneration: " + std::string(reason) + " (Divergence: " + std::to_string(magnitude) + ")";
+        }
+        return std::string();
+    }
 
-    void triggerEvent(Planet& planet) override;
+    // Profils communs aux événements
+    static constexpr float r_s = 0.1f; // Distance that impacts uplift effect
+    static constexpr float max_velocity = 2.0f; // TODO: idk, Timothée knows -> In fact Timothée doesn't know either
 
-    std::string getDescription() const override {
-        return "Subduction: " + reason + " (Convergence: " + std::to_string(convergence) + ")";
+    // 1 - 3x^2 + 2x^3, x = d / r_s, tabulée (cf. UpliftProfiles)
+    static float f(float d) {
+        if (d <= 0.0f) return 1.0f;
+        return UpliftProfiles::falloffSq(d * d / (r_s * r_s)); // TODO: maybe this is not accurate, need to see the function shape
     }
 
-   private:
-    unsigned int plate_under;
-    unsigned int plate_over;
-    float convergence;
-    SubductionType subduction_type;
-    std::string reason;
-};
-
-class ContinentalCollision : public TectonicPhenomenon {
-   public:
-    ContinentalCollision(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
-                         float collisionMagnitude, const std::string& description)
-        : TectonicPhenomenon(Type::ContinentalCollision, plateA, plateB, vertexIndex),
-          magnitude(collisionMagnitude),
-          description(description) {}
+    static float g(float v) {
+        return v/max_velocity;
+    }
 
-    float getMagnitude() const { return magnitude; }
+    static float h(float z) {
+        return z ;
+    }
 
-    void triggerEvent(Planet& planet) override;
-    void triggerTerranesMigration(Planet& planet);
-    std::string getDescription() const override {
-        return "Continental Collision: " + description + " (Magnitude: " + std::to_string(magnitude) + ")";
+    static float elevationImpact(float z, float minZ, float maxZ) {
+        return UpliftProfiles::elevationImpact(z, minZ, maxZ);
     }
+};
 
-   private:
-    float magnitude;
-    std::string description;
+// Segment de frontière : interactions voisines (arêtes du maillage) de même type entre
+// les mêmes plaques, regroupées après la détection. Les événements sont appliqués par
+// segment, et chaque sommet frontière n'appartient qu'à un segment : sa zone d'influence
+// (Plate::closestFrontierVertices) n'est soulevée qu'une fois.
+struct BoundarySegment {
+    TectonicPhenomenon summary;          // premier phénomène, magnitude = moyenne du segment
+    unsigned int interactionCount = 0;   // phénomènes regroupés
+    ArenaVector<unsigned int> frontier;  // sommets frontière dont la zone est traitée par ce segment
 };
 
-class crustGeneration : public TectonicPhenomenon {
-   public:
-
-    crustGeneration(unsigned int plateA, unsigned int plateB, unsigned int vertexIndex,
-            float divergenceRate, const std::string& description)
-            : TectonicPhenomenon(Type::crustGeneration, plateA, plateB, vertexIndex),
-            divergence(divergenceRate),
-            description(description) {}
-
-    crustGeneration(unsigned int plateA,
-            unsigned int plateB, 
-            unsigned int vertexIndex,
-            float divergenceRate,
-            Vec3 closestPlateBoundary,
-            Vec3 q, 
-            const std::string& description)
-
-        : TectonicPhenomenon(Type::crustGeneration, plateA, plateB, vertexIndex),
-          divergence(divergenceRate),
-          closestPlateBoundary(closestPlateBoundary),
-          q(q),
-          description(description) {}
-
-    float getDivergence() const { return divergence; }
-
-    void triggerEvent(Planet& planet) override;
-    std::string getDescription() const override {
-        return "crustGeneration: " + description + " (Divergence: " + std::to_string(divergence) + ")";
-    }
+// Les phénomènes d'un pas sont stockés par valeur dans l'arène du pas (cf. Arena.h)
+typedef ArenaVector<TectonicPhenomenon> PhenomenonList;
+typedef ArenaVector<BoundarySegment> SegmentList;
 
-   private:
-    Vec3 q = Vec3(0.0f,0.0f,0.0f);
-    Vec3 closestPlateBoundary;
-    float divergence;
-    std::string description = "";
+// Contribution d'un événement à un sommet, accumulée par bloc puis appliquée dans
+// l'ordre des blocs (cf. Movement::triggerEvents)
+struct UpliftDelta {
+    unsigned int vertex;
+    float delta;            // ajouté à relief_elevation
+    bool underSubduction;   // marque is_under_subduction au lieu de soulever
 };
+typedef ArenaVector<UpliftDelta> UpliftBuffer;
+
+// Événements, un par type (subduction.cpp, continentalCollision.cpp, crustGeneration.cpp).
+// Le soulèvement est évalué zone par zone (un sommet frontière du segment) sur l'état de
+// la planète au début de l'application, sans écriture : les zones sont indépendantes.
+void evaluateSubduction(const BoundarySegment& segment, unsigned int frontierVertex,
+                        const Planet& planet, UpliftBuffer& uplift);
+void evaluateContinentalCollision(const BoundarySegment& segment, unsigned int frontierVertex,
+                                  const Planet& planet, UpliftBuffer& uplift);
+
+// Noyaux par lots : soulèvement de n sommets à partir du carré de leur distance géodésique
+// au front (Planet::boundaryDistances) et de leur élévation (v : vitesse relative, z : élévation normalisée au contact)
+static const size_t upliftBatchSize = 64;
+void subductionUpliftBatch(const float* distSq, const float* elevation, size_t n,
+                           float v, float z, float* uplift);
+void continentalCollisionUpliftBatch(const float* distSq, const float* elevation, size_t n,
+                                     float v, float minZ, float maxZ,
+                                     const DampingBands& damping, float* uplift);
+void triggerTerranesMigration(const TectonicPhenomenon& phenomenon, Planet& planet);
+// q : point de la ride, closestPlateBoundary : point frontière le plus proche (rééchantillonnage)
+void triggerCrustGeneration(const TectonicPhenomenon& phenomenon, Planet& planet,
+                            Vec3 q, Vec3 closestPlateBoundary);
+
+inline void evaluateEvent(const BoundarySegment& segment, unsigned int frontierVertex,
+                          const Planet& planet, UpliftBuffer& uplift) {
+    switch (segment.summary.type) {
+        case TectonicPhenomenon::Type::Subduction:
+            evaluateSubduction(segment, frontierVertex, planet, uplift);
+            break;
+        case TectonicPhenomenon::Type::ContinentalCollision:
+            evaluateContinentalCollision(segment, frontierVertex, planet, uplift);
+            break;
+        case TectonicPhenomenon::Type::crustGeneration:
+            // Sans point de ride (q nul) l'événement n'a pas d'effet : seul le
+            // rééchantillonnage génère de la croûte (cf. fillDivergentGaps)
+            break;
+    }
+}
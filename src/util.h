@@ -64,17 +64,13 @@ static void drawArrow(const Vec3 & start, const Vec3 & dir, float shaftWidth = 1
 
 static void drawPlateArrows(const Planet & planet, float visualScale = 0.4f) {
 
-    for (const Plate &plate : planet.plates) {
-        if (plate.vertices_indices.empty()) continue;
+    const CentroidTracker& tracker = planet.centroids();
 
+    for (unsigned int p = 0; p < planet.plates.size(); ++p) {
+        const Plate &plate = planet.plates[p];
+        if (plate.vertices_indices.empty()) continue;
 
-        Vec3 centroid(0.0f, 0.0f, 0.0f);
-        for (unsigned int vid : plate.vertices_indices) {
-            if (vid < planet.vertices.size()) centroid += planet.vertices[vid];
-        }
-        centroid /= (float)plate.vertices_indices.size();
-        centroid.normalize();
-        centroid *= planet.radius;
+        Vec3 centroid = tracker.plateCentroid(planet, p);
 
 
         Vec3 linVel = Vec3::cross(plate.rotation_axis, centroid);
@@ -96,34 +92,30 @@ static void drawPlateArrows(const Planet & planet, float visualScale = 0.4f) {
 
 
 
-static void drawTectonicPhenomenaMarkers(const Planet & planet, const std::vector<std::unique_ptr<TectonicPhenomenon>> & phenomena, const  float markerSize = 0.02f) {
+static void drawTectonicPhenomenaMarkers(const Planet & planet, const PhenomenonList & phenomena, const  float markerSize = 0.02f) {
     glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
     glDisable(GL_LIGHTING);
     
     for (const auto& phenomenon : phenomena) {
-        unsigned int vid = phenomenon->getVertexIndex();
+        unsigned int vid = phenomenon.getVertexIndex();
         if (vid >= planet.vertices.size()) continue;
         
-        Vec3 pos = planet.vertices[vid];
+        Vec3 pos = planet.positionOf(vid);
         Vec3 col(1.0f, 1.0f, 1.0f); // default white
         
         // Choose color based on phenomenon type
-        switch (phenomenon->getType()) {
+        switch (phenomenon.getType()) {
             case TectonicPhenomenon::Type::Subduction: {
-                // Cast to Subduction to get subduction-specific info
-                const Subduction* sub = dynamic_cast<const Subduction*>(phenomenon.get());
-                if (sub) {
-                    switch (sub->getSubductionType()) {
-                        case Subduction::SubductionType::Oceanic_Oceanic:
-                            col = Vec3(1.0f, 0.8f, 0.0f); // yellow
-                            break;
-                        case Subduction::SubductionType::Oceanic_Continental:
-                            col = Vec3(1.0f, 0.2f, 0.2f); // red
-                            break;
-                        case Subduction::SubductionType::Continental_Continental:
-                            col = Vec3(1.0f, 0.0f, 1.0f); // magenta
-                            break;
-                    }
+                switch (phenomenon.getSubductionType()) {
+                    case TectonicPhenomenon::SubductionType::Oceanic_Oceanic:
+                        col = Vec3(1.0f, 0.8f, 0.0f); // yellow
+                        break;
+                    case TectonicPhenomenon::SubductionType::Oceanic_Continental:
+                        col = Vec3(1.0f, 0.2f, 0.2f); // red
+                        break;
+                    case TectonicPhenomenon::SubductionType::Continental_Continental:
+                        col = Vec3(1.0f, 0.0f, 1.0f); // magenta
+                        break;
                 }
                 break;
             }